@@ -0,0 +1,48 @@
+#include "bench/bench_compare.hpp"
+#include <cstdio>
+#include <string>
+
+// Compares google-benchmark JSON report against baseline report, exiting with
+// non-zero status if any benchmark got slower by more than threshold percent
+// or if any benchmark of baseline is missing from current report.
+//
+// Usage: ./bench/compare.out <baseline.json> <current.json> [threshold = 15]
+int
+main(int argc, char** argv)
+{
+  if (argc < 3 || argc > 4) {
+    std::fprintf(stderr,
+                 "usage: %s <baseline.json> <current.json> [threshold %%]\n",
+                 argv[0]);
+    return 2;
+  }
+
+  const double threshold = argc == 4 ? std::stod(argv[3]) : 15.;
+
+  try {
+    const auto base = bench_compare::read_json(argv[1]);
+    const auto cur = bench_compare::read_json(argv[2]);
+
+    const auto btimes = bench_compare::timings(base);
+    const auto ctimes = bench_compare::timings(cur);
+
+    const auto res = bench_compare::compare(btimes, ctimes, threshold);
+    if (res.regressed > 0) {
+      std::printf("\n%zu benchmark(s) regressed by more than %.1f%%\n",
+                  res.regressed, threshold);
+    }
+    if (res.missing > 0) {
+      std::printf("\n%zu benchmark(s) of baseline missing from current run\n",
+                  res.missing);
+    }
+    if (res.regressed > 0 || res.missing > 0) {
+      return 1;
+    }
+
+    std::printf("\nno benchmark regressed by more than %.1f%%\n", threshold);
+    return 0;
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 2;
+  }
+}
@@ -1,6 +1,86 @@
 #include "bench/bench_rescue_prime.hpp"
 #include "benchmark/benchmark.h"
 
+// Register for benchmarking prime field primitives
+BENCHMARK(bench_rphash::full_mul_u64);
+BENCHMARK(bench_rphash::ff_add);
+BENCHMARK(bench_rphash::ff_mul);
+BENCHMARK(bench_rphash::ff_sqr);
+
+// Register for benchmarking each pair of scalar multiplication and reduction
+// kernels, available on target, named after `FF_MUL` and `FF_REDUCE` values
+// selecting them, see `make tune`
+using bench_rphash::ff_mul_kernel;
+
+#define FF_MUL_KERNEL(mul, reduce, name)                                       \
+  BENCHMARK_TEMPLATE(ff_mul_kernel, mul, reduce)                               \
+    ->Name("bench_rphash::ff_mul_kernel/" name)
+
+FF_MUL_KERNEL(ff::full_mul_u64_schoolbook,
+              ff::reduce128_generic,
+              "FF_MUL=0/FF_REDUCE=0");
+#if __SIZEOF_INT128__ == 16
+FF_MUL_KERNEL(ff::full_mul_u64_int128,
+              ff::reduce128_generic,
+              "FF_MUL=1/FF_REDUCE=0");
+#endif
+#if defined __x86_64__ && defined __BMI2__
+FF_MUL_KERNEL(ff::full_mul_u64_mulx,
+              ff::reduce128_generic,
+              "FF_MUL=2/FF_REDUCE=0");
+#endif
+#if defined __x86_64__
+FF_MUL_KERNEL(ff::full_mul_u64_schoolbook,
+              ff::reduce128_adx,
+              "FF_MUL=0/FF_REDUCE=1");
+#if __SIZEOF_INT128__ == 16
+FF_MUL_KERNEL(ff::full_mul_u64_int128,
+              ff::reduce128_adx,
+              "FF_MUL=1/FF_REDUCE=1");
+#endif
+#if defined __BMI2__
+FF_MUL_KERNEL(ff::full_mul_u64_mulx, ff::reduce128_adx, "FF_MUL=2/FF_REDUCE=1");
+#endif
+#endif
+
+// Register for benchmarking extension field arithmetic
+using bench_rphash::ext_inv;
+using bench_rphash::ext_mul;
+using bench_rphash::ext_mul_many;
+
+BENCHMARK_TEMPLATE(ext_mul, ff::ff2_t)->Name("bench_rphash::ff2_mul");
+BENCHMARK_TEMPLATE(ext_mul, ff::ff3_t)->Name("bench_rphash::ff3_mul");
+BENCHMARK_TEMPLATE(ext_inv, ff::ff2_t)->Name("bench_rphash::ff2_inv");
+BENCHMARK_TEMPLATE(ext_inv, ff::ff3_t)->Name("bench_rphash::ff3_inv");
+BENCHMARK_TEMPLATE(ext_mul_many, ff::ff2_t)
+  ->Name("bench_rphash::ff2_mul_many")
+  ->Arg(1024);
+BENCHMARK_TEMPLATE(ext_mul_many, ff::ff3_t)
+  ->Name("bench_rphash::ff3_mul_many")
+  ->Arg(1024);
+
+#if defined __AVX2__
+BENCHMARK(bench_rphash::ff_avx_reduce);
+BENCHMARK(bench_rphash::ff_avx_add);
+BENCHMARK(bench_rphash::ff_avx_mul);
+BENCHMARK(bench_rphash::ff_avx_sqr);
+#endif
+#if defined __AVX512F__
+BENCHMARK(bench_rphash::ff_avx512_reduce);
+BENCHMARK(bench_rphash::ff_avx512_add);
+BENCHMARK(bench_rphash::ff_avx512_mul);
+BENCHMARK(bench_rphash::ff_avx512_sqr);
+#endif
+
+// Register for benchmarking individual stages of Rescue permutation
+BENCHMARK(bench_rphash::apply_sbox);
+BENCHMARK(bench_rphash::apply_inv_sbox);
+BENCHMARK(bench_rphash::apply_mds);
+BENCHMARK(bench_rphash::add_rc0);
+BENCHMARK(bench_rphash::add_rc1);
+BENCHMARK(bench_rphash::apply_round);
+BENCHMARK(bench_rphash::permute_batch)->RangeMultiplier(4)->Range(1, 64);
+
 // Register for benchmarking Rescue permutation
 BENCHMARK(bench_rphash::permutation)->UseManualTime();
 
@@ -12,4 +92,108 @@ BENCHMARK(bench_rphash::hash)->Arg(32)->UseManualTime();
 BENCHMARK(bench_rphash::hash)->Arg(64)->UseManualTime();
 BENCHMARK(bench_rphash::hash)->Arg(128)->UseManualTime();
 
+// Register for benchmarking rounds of interactive protocol, using duplex sponge
+BENCHMARK(bench_rphash::sponge_duplex)->Arg(4)->Arg(8)->Arg(16);
+
+// Register for benchmarking batch update of 64 -level sparse Merkle tree
+BENCHMARK(bench_rphash::smt_update)
+  ->ArgsProduct({ { 256, 1024 }, { 1, 2, 4 } })
+  ->Unit(benchmark::kMillisecond);
+
+// Largest input size ( as log2 of bytes ) used in throughput benchmarks, which
+// can be raised up to 30 ( i.e. 1 GiB ) during compilation, see Makefile
+#if !defined MAX_INPUT_LOG2
+#define MAX_INPUT_LOG2 20
+#endif
+
+// Register for benchmarking throughput of Rescue Prime hashing of large inputs
+BENCHMARK(bench_rphash::hash_throughput)
+  ->RangeMultiplier(4)
+  ->Range(1l << 10, 1l << MAX_INPUT_LOG2)
+  ->Unit(benchmark::kMicrosecond);
+
+// Register for benchmarking throughput of Rescue Prime hashing of large inputs,
+// which are not aligned to SIMD register width
+BENCHMARK(bench_rphash::hash_misaligned_throughput)
+  ->RangeMultiplier(4)
+  ->Range(1l << 10, 1l << MAX_INPUT_LOG2)
+  ->Unit(benchmark::kMicrosecond);
+
+// Register for benchmarking throughput and thread scaling of tree mode Rescue
+// Prime hashing of large inputs
+BENCHMARK(bench_rphash::tree_hash_throughput)
+  ->Apply([](auto* b) {
+    bench_rphash::input_sizes_and_threads(b, MAX_INPUT_LOG2);
+  })
+  ->UseRealTime()
+  ->Unit(benchmark::kMicrosecond);
+
+// Register for benchmarking throughput of squeezing large outputs, using
+// sequential and counter mode extendable-output functions
+using bench_rphash::xof_throughput;
+
+BENCHMARK_TEMPLATE(xof_throughput, false)
+  ->Name("bench_rphash::hash_xof")
+  ->RangeMultiplier(8)
+  ->Range(8, 1l << 15)
+  ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(xof_throughput, true)
+  ->Name("bench_rphash::hash_xof_ctr")
+  ->RangeMultiplier(8)
+  ->Range(8, 1l << 15)
+  ->Unit(benchmark::kMicrosecond);
+
+// Register for benchmarking throughput of hashing rows of column-major matrix,
+// directly from columns and from row-major copy of it
+using bench_rphash::hash_rows;
+
+BENCHMARK_TEMPLATE(hash_rows, false)
+  ->Name("bench_rphash::hash_rows_columnar")
+  ->ArgsProduct({ { 1024, 4096 }, { 8, 100 } })
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(hash_rows, true)
+  ->Name("bench_rphash::hash_rows_transposed")
+  ->ArgsProduct({ { 1024, 4096 }, { 8, 100 } })
+  ->Unit(benchmark::kMillisecond);
+
+// Register for benchmarking building Merkle tree of leaves, which are produced
+// before streaming them into builder or pipelined with hashing
+using bench_rphash::merkle_stream;
+
+BENCHMARK_TEMPLATE(merkle_stream, false)
+  ->Name("bench_rphash::merkle_stream_buffered")
+  ->RangeMultiplier(8)
+  ->Range(1 << 10, 1 << 16)
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(merkle_stream, true)
+  ->Name("bench_rphash::merkle_stream_pipelined")
+  ->RangeMultiplier(8)
+  ->Range(1 << 10, 1 << 16)
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
+
+// Register for benchmarking hashing of files, read using io_uring or a reader
+// thread, overlapping reads with absorption
+using bench_rphash::hash_file_ingest;
+
+BENCHMARK_TEMPLATE(hash_file_ingest, ingest::backend_t::io_uring)
+  ->Name("bench_rphash::hash_file_io_uring")
+  ->RangeMultiplier(16)
+  ->Range(1 << 16, 1 << 20)
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(hash_file_ingest, ingest::backend_t::thread)
+  ->Name("bench_rphash::hash_file_reader_thread")
+  ->RangeMultiplier(16)
+  ->Range(1 << 16, 1 << 20)
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
+
+// Register for benchmarking throughput of merging batches of digest pairs
+BENCHMARK(bench_rphash::merge_batch_throughput)
+  ->RangeMultiplier(4)
+  ->Range(1, 4096)
+  ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,187 @@
+#pragma once
+#include "ff.hpp"
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Aligned memory utilities for buffers of prime field ( i.e. Z_q ) elements,
+// so that they can be handed to routines, which use aligned SIMD loads/ stores
+// ( see `rescue::permute` and `rescue::permute_batch` ), without copying
+namespace ff {
+
+// Alignment of buffers, handed out by utilities below, which is enough for
+// AVX2 ( 32 -bytes ), AVX512 ( 64 -bytes ) and NEON ( 16 -bytes ) loads, while
+// also being the size of a cache line on most CPUs
+constexpr size_t ALIGNMENT = 64ul;
+
+// Checks whether given address is aligned to A -bytes boundary
+template<const size_t A = ALIGNMENT, typename T>
+static inline bool
+is_aligned(const T* const ptr)
+{
+  static_assert((A & (A - 1)) == 0, "Alignment must be power of 2 !");
+  return (reinterpret_cast<uintptr_t>(ptr) & (A - 1)) == 0;
+}
+
+// Standard library compatible allocator, handing out A -bytes aligned memory,
+// so that say `std::vector<ff_t, aligned_allocator_t<ff_t>>` can be used as
+// Rescue permutation states or inputs to be loaded using aligned SIMD loads
+template<typename T, const size_t A = ALIGNMENT>
+struct aligned_allocator_t
+{
+  static_assert(A >= alignof(T) && (A & (A - 1)) == 0,
+                "Alignment must be power of 2, not less than that of T !");
+
+  using value_type = T;
+
+  template<typename U>
+  struct rebind
+  {
+    using other = aligned_allocator_t<U, A>;
+  };
+
+  aligned_allocator_t() = default;
+
+  template<typename U>
+  aligned_allocator_t(const aligned_allocator_t<U, A>&)
+  {
+  }
+
+  // Allocates uninitialized memory for N -many elements of type T, throwing
+  // std::bad_alloc on failure
+  T* allocate(const size_t n)
+  {
+    const auto ptr = ::operator new(n * sizeof(T), std::align_val_t{ A });
+    return static_cast<T*>(ptr);
+  }
+
+  // Deallocates memory, obtained using `allocate`
+  void deallocate(T* const ptr, const size_t)
+  {
+    ::operator delete(ptr, std::align_val_t{ A });
+  }
+
+  template<typename U>
+  bool operator==(const aligned_allocator_t<U, A>&) const
+  {
+    return true;
+  }
+};
+
+// Vector of elements, whose underlying buffer is A -bytes aligned
+template<typename T, const size_t A = ALIGNMENT>
+using aligned_vector_t = std::vector<T, aligned_allocator_t<T, A>>;
+
+// Span of elements, whose starting address is known to be A -bytes aligned,
+// which is checked once, when constructed, so that routines accepting it can
+// use aligned SIMD loads/ stores, without checking alignment again.
+//
+// If starting address is not aligned to A -bytes boundary, program will panic
+// ( in debug builds ) !
+template<typename T, const size_t A = ALIGNMENT>
+struct aligned_span_t
+{
+  static_assert((A & (A - 1)) == 0, "Alignment must be power of 2 !");
+
+  std::span<T> elms;
+
+  aligned_span_t() = default;
+
+  explicit aligned_span_t(const std::span<T> s)
+    : elms(s)
+  {
+    assert(is_aligned<A>(s.data()));
+  }
+
+  aligned_span_t(T* const ptr, const size_t n)
+    : aligned_span_t(std::span<T>{ ptr, n })
+  {
+  }
+
+  // Aligned spans can be created from aligned vectors of same alignment, or
+  // coarser one, without checking alignment again
+  template<typename U, const size_t B>
+    requires(B >= A && std::is_convertible_v<U (*)[], T (*)[]>)
+  aligned_span_t(std::vector<U, aligned_allocator_t<U, B>>& v)
+    : elms(v)
+  {
+  }
+
+  template<typename U, const size_t B>
+    requires(B >= A && std::is_convertible_v<const U (*)[], T (*)[]>)
+  aligned_span_t(const std::vector<U, aligned_allocator_t<U, B>>& v)
+    : elms(v)
+  {
+  }
+
+  // Aligned spans can be narrowed to finer alignment, without checking again
+  template<const size_t B>
+    requires(B > A)
+  aligned_span_t(const aligned_span_t<T, B> s)
+    : elms(s.elms)
+  {
+  }
+
+  T* data() const { return std::assume_aligned<A>(elms.data()); }
+  size_t size() const { return elms.size(); }
+  bool empty() const { return elms.empty(); }
+  T& operator[](const size_t i) const { return data()[i]; }
+
+  // Subspan, starting at given offset, which must keep it A -bytes aligned
+  aligned_span_t subspan(const size_t off, const size_t n) const
+  {
+    return aligned_span_t{ elms.subspan(off, n) };
+  }
+
+  operator std::span<T>() const { return elms; }
+};
+
+// Bump allocator, handing out A -bytes aligned buffers of Z_q elements from a
+// single aligned block of memory, allocated once, so that scratch buffers ( say
+// permutation states of a batch ) can be obtained repeatedly, without touching
+// heap allocator, until arena is reset.
+//
+// Buffers are uninitialized and are valid until arena is reset/ destroyed.
+template<const size_t A = ALIGNMENT>
+struct arena_t
+{
+  aligned_vector_t<ff_t, A> buf;
+  size_t used = 0;
+
+  // Creates an arena, which can hand out upto `cap` -many Z_q elements, in
+  // total, including padding for keeping each buffer aligned
+  explicit arena_t(const size_t cap)
+    : buf(cap)
+  {
+  }
+
+  // Hands out an aligned buffer of N -many Z_q elements, if arena has enough
+  // free space, otherwise returns empty span
+  aligned_span_t<ff_t, A> alloc(const size_t n)
+  {
+    constexpr size_t per_blk = A / sizeof(ff_t);
+    const size_t beg = (used + per_blk - 1) / per_blk * per_blk;
+
+    if (beg > buf.size() || n > buf.size() - beg) {
+      return aligned_span_t<ff_t, A>{};
+    }
+
+    used = beg + n;
+    return aligned_span_t<ff_t, A>{ buf.data() + beg, n };
+  }
+
+  // Number of Z_q elements handed out so far, including padding
+  size_t size() const { return used; }
+
+  // Number of Z_q elements, which can be handed out, in total
+  size_t capacity() const { return buf.size(); }
+
+  // Reclaims all buffers handed out so far, which must not be used anymore
+  void reset() { used = 0; }
+};
+
+}
@@ -1,9 +1,18 @@
 #pragma once
+#include "bench_histogram.hpp"
+#include "bench_perf.hpp"
+#include "ff.hpp"
 #include <algorithm>
 #include <benchmark/benchmark.h>
 #include <chrono>
+#include <cstdint>
+#include <random>
 #include <vector>
 
+#if defined __x86_64__ || defined __i386__
+#include <x86intrin.h>
+#endif
+
 // Benchmark Rescue Prime hash and its components, using google-benchmark
 namespace bench_rphash {
 
@@ -14,4 +23,69 @@ using seconds_t = std::chrono::duration<double>;
 // minimum, median and maximum execution times
 using nano_t = std::chrono::nanoseconds;
 
+// Generates N -many random elements ∈ Z_q, for preparing benchmark input,
+// outside of timed region. Unlike `ff::ff_t::random`, it seeds PRNG only
+// once, so that filling up large ( say GiB sized ) inputs doesn't take forever.
+inline std::vector<ff::ff_t>
+random_elements(const size_t n)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint64_t> dis{ 0ul, ff::Q - 1ul };
+
+  std::vector<ff::ff_t> elms(n);
+  for (size_t i = 0; i < n; i++) {
+    elms[i] = ff::ff_t{ dis(gen) };
+  }
+
+  return elms;
+}
+
+// Reads CPU timestamp counter, which is used for reporting cycles spent per
+// call of benchmarked routine.
+//
+// On x86_64, it's `rdtsc` i.e. it ticks at constant ( nominal ) frequency, so
+// it matches actual core cycles only when frequency scaling is disabled. On
+// aarch64, it's the virtual counter, ticking at a fixed frequency, which is
+// usually much lower than core frequency. Elsewhere, it's always 0.
+static inline uint64_t
+cycles()
+{
+#if defined __x86_64__ || defined __i386__
+  return __rdtsc();
+#elif defined __aarch64__
+  uint64_t v;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+  return v;
+#else
+  return 0ul;
+#endif
+}
+
+// Name of the backend used for Rescue permutation, as selected during
+// compilation, which is attached to per-stage benchmark results as label
+static inline const char*
+backend()
+{
+#if defined __AVX2__ && USE_AVX2 != 0
+  return "avx2";
+#elif defined __ARM_NEON && USE_NEON != 0
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
+
+// Reports average number of cycles ( see `cycles` ) spent per call, given
+// total cycles spent in `calls_per_iter` calls per benchmark iteration
+inline void
+report_cycles(benchmark::State& state,
+              const uint64_t total_cycles,
+              const size_t calls_per_iter = 1)
+{
+  const auto per_iter = static_cast<double>(total_cycles) / calls_per_iter;
+  state.counters["cycles/call"] =
+    benchmark::Counter(per_iter, benchmark::Counter::kAvgIterations);
+}
+
 }
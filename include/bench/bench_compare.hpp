@@ -0,0 +1,390 @@
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Compare google-benchmark JSON reports, for catching performance regressions
+namespace bench_compare {
+
+// Minimal JSON value, enough for reading google-benchmark JSON reports
+struct json_t
+{
+  enum class kind_t
+  {
+    null,
+    boolean,
+    number,
+    string,
+    array,
+    object,
+  };
+
+  kind_t kind = kind_t::null;
+  bool b = false;
+  double num = 0.;
+  std::string str;
+  std::vector<json_t> elms;      // elements of array/ values of object
+  std::vector<std::string> keys; // keys of object, same order as `elms`
+
+  // Returns value associated with given key, if this is an object holding it,
+  // otherwise returns nullptr
+  inline const json_t* get(const std::string& key) const
+  {
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (keys[i] == key) {
+        return &elms[i];
+      }
+    }
+    return nullptr;
+  }
+};
+
+// Recursive descent parser of JSON text, throwing std::runtime_error on
+// malformed input
+struct json_parser_t
+{
+  const std::string& txt;
+  size_t off = 0;
+
+  inline explicit json_parser_t(const std::string& t)
+    : txt(t)
+  {
+  }
+
+  inline json_t parse()
+  {
+    json_t v = value();
+    skip_ws();
+    if (off != txt.size()) {
+      fail("trailing characters");
+    }
+    return v;
+  }
+
+private:
+  [[noreturn]] inline void fail(const char* const what) const
+  {
+    throw std::runtime_error(std::string("json: ") + what + " at offset " +
+                             std::to_string(off));
+  }
+
+  inline void skip_ws()
+  {
+    while (off < txt.size() && (txt[off] == ' ' || txt[off] == '\n' ||
+                                txt[off] == '\r' || txt[off] == '\t')) {
+      off++;
+    }
+  }
+
+  inline void expect(const char c)
+  {
+    skip_ws();
+    if (off >= txt.size() || txt[off] != c) {
+      fail("unexpected character");
+    }
+    off++;
+  }
+
+  inline bool consume(const char* const lit)
+  {
+    const std::string l(lit);
+    if (txt.compare(off, l.size(), l) == 0) {
+      off += l.size();
+      return true;
+    }
+    return false;
+  }
+
+  inline json_t value()
+  {
+    skip_ws();
+    if (off >= txt.size()) {
+      fail("unexpected end of input");
+    }
+
+    json_t v;
+    const char c = txt[off];
+
+    if (c == '{') {
+      v.kind = json_t::kind_t::object;
+      off++;
+      skip_ws();
+      if (off < txt.size() && txt[off] == '}') {
+        off++;
+        return v;
+      }
+      while (true) {
+        skip_ws();
+        v.keys.push_back(string());
+        expect(':');
+        v.elms.push_back(value());
+        skip_ws();
+        if (off < txt.size() && txt[off] == ',') {
+          off++;
+          continue;
+        }
+        expect('}');
+        return v;
+      }
+    }
+
+    if (c == '[') {
+      v.kind = json_t::kind_t::array;
+      off++;
+      skip_ws();
+      if (off < txt.size() && txt[off] == ']') {
+        off++;
+        return v;
+      }
+      while (true) {
+        v.elms.push_back(value());
+        skip_ws();
+        if (off < txt.size() && txt[off] == ',') {
+          off++;
+          continue;
+        }
+        expect(']');
+        return v;
+      }
+    }
+
+    if (c == '"') {
+      v.kind = json_t::kind_t::string;
+      v.str = string();
+      return v;
+    }
+
+    if (consume("true")) {
+      v.kind = json_t::kind_t::boolean;
+      v.b = true;
+      return v;
+    }
+
+    if (consume("false")) {
+      v.kind = json_t::kind_t::boolean;
+      return v;
+    }
+
+    if (consume("null")) {
+      return v;
+    }
+
+    const char* const beg = txt.c_str() + off;
+    char* end = nullptr;
+    v.kind = json_t::kind_t::number;
+    v.num = std::strtod(beg, &end);
+    if (end == beg) {
+      fail("invalid value");
+    }
+    off += static_cast<size_t>(end - beg);
+    return v;
+  }
+
+  // Parses a string literal; escaped characters other than `\uXXXX` are kept
+  // as is, while `\uXXXX` is replaced by '?', as names of benchmarks are ASCII
+  inline std::string string()
+  {
+    if (off >= txt.size() || txt[off] != '"') {
+      fail("expected string");
+    }
+    off++;
+
+    std::string s;
+    while (off < txt.size() && txt[off] != '"') {
+      if (txt[off] == '\\') {
+        off++;
+        if (off >= txt.size()) {
+          break;
+        }
+
+        switch (txt[off]) {
+          case 'n':
+            s.push_back('\n');
+            break;
+          case 't':
+            s.push_back('\t');
+            break;
+          case 'r':
+            s.push_back('\r');
+            break;
+          case 'b':
+            s.push_back('\b');
+            break;
+          case 'f':
+            s.push_back('\f');
+            break;
+          case 'u':
+            s.push_back('?');
+            off += 4;
+            break;
+          default:
+            s.push_back(txt[off]);
+        }
+        off++;
+        continue;
+      }
+
+      s.push_back(txt[off]);
+      off++;
+    }
+
+    if (off >= txt.size()) {
+      fail("unterminated string");
+    }
+    off++;
+    return s;
+  }
+};
+
+// Reads and parses JSON file, throwing std::runtime_error on failure
+inline json_t
+read_json(const std::string& path)
+{
+  std::ifstream f(path);
+  if (!f) {
+    throw std::runtime_error("can't open " + path);
+  }
+
+  std::stringstream ss;
+  ss << f.rdbuf();
+
+  const std::string txt = ss.str();
+  return json_parser_t{ txt }.parse();
+}
+
+// Execution time of a benchmark, as found in google-benchmark JSON report
+struct timing_t
+{
+  std::string name;
+  double ns; // real time in nanoseconds
+};
+
+// Converts time, in given google-benchmark time unit, to nanoseconds
+inline double
+to_ns(const double t, const std::string& unit)
+{
+  if (unit == "us") {
+    return t * 1e3;
+  }
+  if (unit == "ms") {
+    return t * 1e6;
+  }
+  if (unit == "s") {
+    return t * 1e9;
+  }
+  return t;
+}
+
+// Extracts real time of each benchmark from google-benchmark JSON report. When
+// report holds repetitions, only median aggregate is considered, otherwise
+// each run is considered.
+inline std::vector<timing_t>
+timings(const json_t& report)
+{
+  const json_t* const benches = report.get("benchmarks");
+  if (benches == nullptr || benches->kind != json_t::kind_t::array) {
+    throw std::runtime_error("report doesn't hold `benchmarks` array");
+  }
+
+  bool has_median = false;
+  for (const auto& b : benches->elms) {
+    const json_t* const agg = b.get("aggregate_name");
+    has_median |= agg != nullptr && agg->str == "median";
+  }
+
+  std::vector<timing_t> res;
+  for (const auto& b : benches->elms) {
+    const json_t* const name = b.get("run_name");
+    const json_t* const real = b.get("real_time");
+    const json_t* const unit = b.get("time_unit");
+    const json_t* const type = b.get("run_type");
+    const json_t* const agg = b.get("aggregate_name");
+
+    if (name == nullptr || real == nullptr) {
+      continue;
+    }
+
+    const bool is_agg = type != nullptr && type->str == "aggregate";
+    if (has_median && !(is_agg && agg != nullptr && agg->str == "median")) {
+      continue;
+    }
+    if (!has_median && is_agg) {
+      continue;
+    }
+
+    const std::string u = unit != nullptr ? unit->str : "ns";
+    res.push_back(timing_t{ name->str, to_ns(real->num, u) });
+  }
+
+  return res;
+}
+
+// Outcome of comparing current report against baseline
+struct result_t
+{
+  // # -of benchmarks slower than baseline, by more than threshold
+  size_t regressed = 0;
+
+  // # -of baseline benchmarks, absent from current report, which can't be
+  // checked for regression
+  size_t missing = 0;
+};
+
+// Compares execution time of each benchmark, present in both baseline and
+// current report, printing relative change and flagging it, if it's slower by
+// more than `threshold` percent. Benchmarks of baseline, which are absent from
+// current report, are flagged as missing.
+inline result_t
+compare(const std::vector<timing_t>& baseline,
+        const std::vector<timing_t>& current,
+        const double threshold)
+{
+  result_t res;
+
+  std::printf("%-56s %14s %14s %9s\n", "Benchmark", "Baseline (ns)",
+              "Current (ns)", "Change");
+
+  for (const auto& cur : current) {
+    const timing_t* base = nullptr;
+    for (const auto& b : baseline) {
+      if (b.name == cur.name) {
+        base = &b;
+        break;
+      }
+    }
+
+    if (base == nullptr) {
+      std::printf("%-56s %14s %14.1f %9s\n", cur.name.c_str(), "-", cur.ns,
+                  "new");
+      continue;
+    }
+
+    const double change = (cur.ns / base->ns - 1.) * 100.;
+    const bool slow = change > threshold;
+    res.regressed += slow;
+
+    std::printf("%-56s %14.1f %14.1f %+8.1f%%%s\n", cur.name.c_str(),
+                base->ns, cur.ns, change, slow ? "  REGRESSED" : "");
+  }
+
+  for (const auto& b : baseline) {
+    bool found = false;
+    for (const auto& cur : current) {
+      found |= cur.name == b.name;
+    }
+
+    if (!found) {
+      res.missing++;
+      std::printf("%-56s %14.1f %14s %9s\n", b.name.c_str(), b.ns, "-",
+                  "MISSING");
+    }
+  }
+
+  return res;
+}
+
+}
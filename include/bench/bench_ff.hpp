@@ -0,0 +1,257 @@
+#pragma once
+#include "bench_common.hpp"
+#include "ff.hpp"
+#include "ff_avx.hpp"
+#include "ff_avx512.hpp"
+#include "ff_ext.hpp"
+
+// Benchmark Rescue Prime hash and its components, using google-benchmark
+namespace bench_rphash {
+
+// Number of dependent calls of benchmarked field primitive, made per benchmark
+// iteration, so that loop overhead doesn't dominate measured time
+constexpr size_t FF_CHAIN_LEN = 32;
+
+// Benchmarks a prime field primitive, which is invoked `FF_CHAIN_LEN` -many
+// times per iteration, where each call depends on result of previous one, so
+// reported wall time and cycles per call approximates latency of routine.
+template<typename T, typename Op>
+inline void
+ff_primitive(benchmark::State& state, T acc, Op&& op)
+{
+  perf_counters_t perf;
+
+  perf.start();
+  const uint64_t c0 = cycles();
+  for (auto _ : state) {
+    for (size_t i = 0; i < FF_CHAIN_LEN; i++) {
+      acc = op(acc);
+    }
+    benchmark::DoNotOptimize(acc);
+  }
+  const uint64_t c1 = cycles();
+  perf.stop();
+
+  report_cycles(state, c1 - c0, FF_CHAIN_LEN);
+  perf.report(state, FF_CHAIN_LEN);
+  state.SetItemsProcessed(
+    static_cast<int64_t>(FF_CHAIN_LEN * state.iterations()));
+}
+
+// Benchmark full multiplication of two 64 -bit unsigned integers
+inline void
+full_mul_u64(benchmark::State& state)
+{
+  const uint64_t b = ff::ff_t::random().v;
+
+  ff_primitive(state, ff::ff_t::random().v, [=](const uint64_t a) {
+    const auto [hi, lo] = ff::full_mul_u64(a, b);
+    return hi ^ lo;
+  });
+}
+
+// Benchmark prime field addition, on scalar elements
+inline void
+ff_add(benchmark::State& state)
+{
+  const auto b = ff::ff_t::random();
+  ff_primitive(state, ff::ff_t::random(), [=](const ff::ff_t a) {
+    return a + b;
+  });
+}
+
+// Benchmark prime field multiplication, on scalar elements
+inline void
+ff_mul(benchmark::State& state)
+{
+  const auto b = ff::ff_t::random();
+  ff_primitive(state, ff::ff_t::random(), [=](const ff::ff_t a) {
+    return a * b;
+  });
+}
+
+// Benchmark prime field squaring, on scalar elements
+inline void
+ff_sqr(benchmark::State& state)
+{
+  ff_primitive(state, ff::ff_t::random(), [](const ff::ff_t a) {
+    return a.square();
+  });
+}
+
+// Benchmark prime field multiplication, on scalar elements, using given 128
+// -bit multiplication and reduction kernels ( see `FF_MUL` and `FF_REDUCE` in
+// ff.hpp ), so that best performing pair of kernels can be selected for target,
+// using `make tune`
+template<auto mul, auto reduce>
+inline void
+ff_mul_kernel(benchmark::State& state)
+{
+  const uint64_t b = ff::ff_t::random().v;
+
+  ff_primitive(state, ff::ff_t::random().v, [=](const uint64_t a) {
+    const auto [hi, lo] = mul(a, b);
+    return ff::ff_t{ reduce(hi, lo) }.v;
+  });
+}
+
+// Benchmark multiplication over quadratic/ cubic extension of Z_q, on scalar
+// elements
+template<typename E>
+inline void
+ext_mul(benchmark::State& state)
+{
+  const auto b = E::random();
+  ff_primitive(state, E::random(), [=](const E a) { return a * b; });
+}
+
+// Benchmark inversion over quadratic/ cubic extension of Z_q, on scalar
+// elements
+template<typename E>
+inline void
+ext_inv(benchmark::State& state)
+{
+  ff_primitive(state, E::random(), [](const E a) { return a.inv(); });
+}
+
+// Benchmark element wise multiplication of two arrays of N ( > 0 ) -many
+// elements of quadratic/ cubic extension of Z_q, using batched kernel, which
+// is vectorized, when SIMD backend is enabled
+template<typename E>
+inline void
+ext_mul_many(benchmark::State& state)
+{
+  const size_t n = state.range(0);
+
+  std::vector<E> a(n), b(n), c(n);
+  for (size_t i = 0; i < n; i++) {
+    a[i] = E::random();
+    b[i] = E::random();
+  }
+
+  const uint64_t c0 = cycles();
+  for (auto _ : state) {
+    ff::mul_many(a.data(), b.data(), c.data(), n);
+    benchmark::DoNotOptimize(c.data());
+    benchmark::ClobberMemory();
+  }
+  const uint64_t c1 = cycles();
+
+  report_cycles(state, c1 - c0, n);
+  state.SetItemsProcessed(static_cast<int64_t>(n * state.iterations()));
+}
+
+#if defined __AVX2__
+
+// Generates four random prime field elements, in a 256 -bit register
+inline ff::ff_avx_t
+random_avx()
+{
+  alignas(32) ff::ff_t arr[4];
+  for (size_t i = 0; i < 4; i++) {
+    arr[i] = ff::ff_t::random();
+  }
+  return ff::ff_avx_t{ arr };
+}
+
+// Benchmark reduction of four 64 -bit unsigned integers to prime field Z_q
+inline void
+ff_avx_reduce(benchmark::State& state)
+{
+  const auto one = _mm256_set1_epi64x(1);
+
+  ff_primitive(state, random_avx().v, [=](const __m256i a) {
+    return ff::reduce(_mm256_add_epi64(a, one));
+  });
+}
+
+// Benchmark prime field addition, on four elements, using AVX2 intrinsics
+inline void
+ff_avx_add(benchmark::State& state)
+{
+  const auto b = random_avx();
+  ff_primitive(state, random_avx(), [=](const ff::ff_avx_t a) {
+    return a + b;
+  });
+}
+
+// Benchmark prime field multiplication, on four elements, using AVX2
+// intrinsics
+inline void
+ff_avx_mul(benchmark::State& state)
+{
+  const auto b = random_avx();
+  ff_primitive(state, random_avx(), [=](const ff::ff_avx_t a) {
+    return a * b;
+  });
+}
+
+// Benchmark prime field squaring, on four elements, using AVX2 intrinsics
+inline void
+ff_avx_sqr(benchmark::State& state)
+{
+  ff_primitive(state, random_avx(), [](const ff::ff_avx_t a) {
+    return a.square();
+  });
+}
+
+#endif
+
+#if defined __AVX512F__
+
+// Generates eight random prime field elements, in a 512 -bit register
+inline ff::ff_avx512_t
+random_avx512()
+{
+  alignas(64) ff::ff_t arr[8];
+  for (size_t i = 0; i < 8; i++) {
+    arr[i] = ff::ff_t::random();
+  }
+  return ff::ff_avx512_t{ arr };
+}
+
+// Benchmark reduction of eight 64 -bit unsigned integers to prime field Z_q
+inline void
+ff_avx512_reduce(benchmark::State& state)
+{
+  const auto one = _mm512_set1_epi64(1);
+
+  ff_primitive(state, random_avx512().v, [=](const __m512i a) {
+    return ff::reduce(_mm512_add_epi64(a, one));
+  });
+}
+
+// Benchmark prime field addition, on eight elements, using AVX512 intrinsics
+inline void
+ff_avx512_add(benchmark::State& state)
+{
+  const auto b = random_avx512();
+  ff_primitive(state, random_avx512(), [=](const ff::ff_avx512_t a) {
+    return a + b;
+  });
+}
+
+// Benchmark prime field multiplication, on eight elements, using AVX512
+// intrinsics
+inline void
+ff_avx512_mul(benchmark::State& state)
+{
+  const auto b = random_avx512();
+  ff_primitive(state, random_avx512(), [=](const ff::ff_avx512_t a) {
+    return a * b;
+  });
+}
+
+// Benchmark prime field squaring, on eight elements, using AVX512
+// intrinsics
+inline void
+ff_avx512_sqr(benchmark::State& state)
+{
+  ff_primitive(state, random_avx512(), [](const ff::ff_avx512_t a) {
+    return a.square();
+  });
+}
+
+#endif
+
+}
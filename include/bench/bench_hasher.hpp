@@ -1,6 +1,7 @@
 #pragma once
 #include "bench_common.hpp"
 #include "rescue_prime.hpp"
+#include "sponge.hpp"
 
 // Benchmark Rescue Prime hash and its components, using google-benchmark
 namespace bench_rphash {
@@ -15,13 +16,15 @@ hash(benchmark::State& state)
   auto* input = static_cast<ff::ff_t*>(std::malloc(ilen * sizeof(ff::ff_t)));
   auto* output = static_cast<ff::ff_t*>(std::malloc(olen * sizeof(ff::ff_t)));
 
-  std::vector<uint64_t> durations;
+  latency_histogram_t latencies;
+  perf_counters_t perf;
 
   for (auto _ : state) {
     for (size_t i = 0; i < ilen; i++) {
       input[i] = ff::ff_t::random();
     }
 
+    perf.start();
     const auto t0 = std::chrono::high_resolution_clock::now();
 
     rescue_prime::hash(input, ilen, output);
@@ -31,32 +34,45 @@ hash(benchmark::State& state)
     benchmark::ClobberMemory();
 
     const auto t1 = std::chrono::high_resolution_clock::now();
+    perf.stop();
 
     const auto sdur = std::chrono::duration_cast<seconds_t>(t1 - t0);
     const auto nsdur = std::chrono::duration_cast<nano_t>(t1 - t0);
 
     state.SetIterationTime(sdur.count());
-    durations.push_back(nsdur.count());
+    latencies.record(nsdur.count());
   }
 
   state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  perf.report(state);
+  latencies.report(state);
 
-  const auto min_idx = std::min_element(durations.begin(), durations.end());
-  const auto min = durations.at(std::distance(durations.begin(), min_idx));
-  state.counters["min_exec_time (ns)"] = static_cast<double>(min);
+  std::free(input);
+  std::free(output);
+}
 
-  const auto max_idx = std::max_element(durations.begin(), durations.end());
-  const auto max = durations.at(std::distance(durations.begin(), max_idx));
-  state.counters["max_exec_time (ns)"] = static_cast<double>(max);
+// Benchmark a round of an interactive protocol, using duplex sponge, where a
+// prover message of M ( > 0 ) -many elements is absorbed and two challenges are
+// squeezed, reporting number of rounds per second
+inline void
+sponge_duplex(benchmark::State& state)
+{
+  const size_t mlen = state.range();
 
-  const auto lenby2 = durations.size() / 2;
-  const auto mid_idx = durations.begin() + lenby2;
-  std::nth_element(durations.begin(), mid_idx, durations.end());
-  const auto mid = durations[lenby2];
-  state.counters["median_exec_time (ns)"] = static_cast<double>(mid);
+  const auto msg = random_elements(mlen);
+  ff::ff_t challenges[2];
 
-  std::free(input);
-  std::free(output);
+  rescue_prime::sponge_t sponge;
+
+  for (auto _ : state) {
+    sponge.absorb(msg);
+    sponge.squeeze(challenges);
+
+    benchmark::DoNotOptimize(challenges);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
 }
 
 }
@@ -0,0 +1,110 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+// Benchmark Rescue Prime hash and its components, using google-benchmark
+namespace bench_rphash {
+
+// Latency recorder, keeping a fixed-memory histogram of recorded values ( say
+// execution time in nanoseconds ), bucketed logarithmically, in style of HDR
+// histogram, so that recording is allocation free and takes constant time.
+//
+// Each power of two range [2^m, 2^(m+1)) is splitted into 2^SUB_BITS equal
+// width buckets, which bounds relative error of reported percentiles to
+// 2^-SUB_BITS ( i.e. ~3% ), while values < 2^SUB_BITS are recorded exactly.
+struct latency_histogram_t
+{
+  static constexpr size_t SUB_BITS = 5;
+  static constexpr size_t SUB_CNT = 1ul << SUB_BITS;
+  static constexpr size_t BUCKET_CNT = (64 - SUB_BITS + 1) * SUB_CNT;
+
+  std::array<uint64_t, BUCKET_CNT> buckets{};
+  uint64_t cnt = 0;
+  uint64_t lo = UINT64_MAX;
+  uint64_t hi = 0;
+
+  // Computes index of bucket, holding given value
+  static inline constexpr size_t bucket_of(const uint64_t v)
+  {
+    if (v < SUB_CNT) {
+      return static_cast<size_t>(v);
+    }
+
+    const size_t m = 63 - static_cast<size_t>(__builtin_clzl(v));
+    const size_t sub = static_cast<size_t>(v >> (m - SUB_BITS)) & (SUB_CNT - 1);
+
+    return ((m - SUB_BITS + 1) << SUB_BITS) + sub;
+  }
+
+  // Computes largest value, which can be held in bucket of given index
+  static inline constexpr uint64_t highest_of(const size_t idx)
+  {
+    if (idx < SUB_CNT) {
+      return static_cast<uint64_t>(idx);
+    }
+
+    const size_t m = (idx >> SUB_BITS) + SUB_BITS - 1;
+    const uint64_t sub = SUB_CNT + (idx & (SUB_CNT - 1));
+    const uint64_t width = 1ul << (m - SUB_BITS);
+
+    return (sub << (m - SUB_BITS)) + (width - 1);
+  }
+
+  // Records a value
+  inline void record(const uint64_t v)
+  {
+    buckets[bucket_of(v)]++;
+    cnt++;
+    lo = std::min(lo, v);
+    hi = std::max(hi, v);
+  }
+
+  // Number of recorded values
+  inline uint64_t count() const { return cnt; }
+
+  // Smallest recorded value, it's exact
+  inline uint64_t min() const { return cnt == 0 ? 0 : lo; }
+
+  // Largest recorded value, it's exact
+  inline uint64_t max() const { return hi; }
+
+  // Computes p -th percentile | p ∈ [0, 100] of recorded values, which is
+  // reported as largest value of bucket holding it, capped at largest recorded
+  // value
+  inline uint64_t percentile(const double p) const
+  {
+    if (cnt == 0) {
+      return 0;
+    }
+
+    const double frac = std::clamp(p, 0., 100.) / 100.;
+    const auto rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(frac * static_cast<double>(cnt) + .5));
+
+    uint64_t acc = 0;
+    for (size_t i = 0; i < BUCKET_CNT; i++) {
+      acc += buckets[i];
+      if (acc >= rank) {
+        return std::clamp(highest_of(i), min(), max());
+      }
+    }
+
+    return max();
+  }
+
+  // Reports min, p50, p90, p99, p99.9 and max of recorded values, which are
+  // execution times in nanoseconds, as google-benchmark counters
+  inline void report(benchmark::State& state) const
+  {
+    state.counters["min (ns)"] = static_cast<double>(min());
+    state.counters["p50 (ns)"] = static_cast<double>(percentile(50.));
+    state.counters["p90 (ns)"] = static_cast<double>(percentile(90.));
+    state.counters["p99 (ns)"] = static_cast<double>(percentile(99.));
+    state.counters["p99.9 (ns)"] = static_cast<double>(percentile(99.9));
+    state.counters["max (ns)"] = static_cast<double>(max());
+  }
+};
+
+}
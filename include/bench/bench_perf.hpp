@@ -0,0 +1,196 @@
+#pragma once
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+
+#if defined __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Benchmark Rescue Prime hash and its components, using google-benchmark
+namespace bench_rphash {
+
+// Hardware events, counted using Linux `perf_event_open`, while benchmarking
+enum class perf_event_t : size_t
+{
+  instructions = 0,
+  cycles,
+  l1d_misses,
+  branch_misses,
+};
+
+// Number of hardware events, which are counted
+constexpr size_t PERF_EVENT_CNT = 4;
+
+// Name of hardware event, used for reporting it as google-benchmark counter
+constexpr std::array<const char*, PERF_EVENT_CNT> PERF_EVENT_NAMES{
+  "instructions",
+  "cycles",
+  "L1D-misses",
+  "branch-misses",
+};
+
+// Hardware performance counters of calling thread ( and threads spawned by it
+// while counters are enabled ), only counting user-space events, opened using
+// Linux `perf_event_open` system call.
+//
+// Each event is opened on its own, so that if some of them are not supported
+// by CPU/ kernel/ hypervisor, remaining ones are still counted. When none of
+// them can be opened ( say on non-Linux targets, in containers, with
+// restrictive `kernel.perf_event_paranoid` ), this is a no-op and no counter
+// is reported.
+struct perf_counters_t
+{
+  std::array<int, PERF_EVENT_CNT> fds;
+  std::array<uint64_t, PERF_EVENT_CNT> counts{};
+
+  // Opens ( but doesn't yet enable ) all hardware event counters
+  inline perf_counters_t()
+  {
+    fds.fill(-1);
+
+#if defined __linux__
+    for (size_t i = 0; i < PERF_EVENT_CNT; i++) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+
+      attr.size = sizeof(attr);
+      attr.disabled = 1;
+      attr.inherit = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      switch (static_cast<perf_event_t>(i)) {
+        case perf_event_t::instructions:
+          attr.type = PERF_TYPE_HARDWARE;
+          attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+          break;
+        case perf_event_t::cycles:
+          attr.type = PERF_TYPE_HARDWARE;
+          attr.config = PERF_COUNT_HW_CPU_CYCLES;
+          break;
+        case perf_event_t::l1d_misses:
+          attr.type = PERF_TYPE_HW_CACHE;
+          attr.config = PERF_COUNT_HW_CACHE_L1D |
+                        (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+          break;
+        case perf_event_t::branch_misses:
+          attr.type = PERF_TYPE_HARDWARE;
+          attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+          break;
+      }
+
+      const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+      fds[i] = static_cast<int>(fd);
+    }
+#endif
+  }
+
+  perf_counters_t(const perf_counters_t&) = delete;
+  perf_counters_t& operator=(const perf_counters_t&) = delete;
+
+  // Closes all opened hardware event counters
+  inline ~perf_counters_t()
+  {
+#if defined __linux__
+    for (const int fd : fds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+#endif
+  }
+
+  // Whether hardware event counter, of given kind, could be opened or not
+  inline bool available(const perf_event_t evt) const
+  {
+    return fds[static_cast<size_t>(evt)] >= 0;
+  }
+
+  // Starts counting hardware events, resuming from where it was last stopped
+  inline void start()
+  {
+#if defined __linux__
+    for (const int fd : fds) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  // Stops counting hardware events
+  inline void stop()
+  {
+#if defined __linux__
+    for (const int fd : fds) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      }
+    }
+#endif
+  }
+
+  // Reads hardware event counts accumulated so far, scaling them up, if kernel
+  // had to multiplex counters ( i.e. events were not counted all the time they
+  // were enabled )
+  inline void read()
+  {
+#if defined __linux__
+    for (size_t i = 0; i < PERF_EVENT_CNT; i++) {
+      if (fds[i] < 0) {
+        continue;
+      }
+
+      // value, time enabled, time running
+      uint64_t buf[3]{};
+      if (::read(fds[i], buf, sizeof(buf)) != sizeof(buf)) {
+        continue;
+      }
+
+      if (buf[2] != 0 && buf[2] < buf[1]) {
+        const double scale = static_cast<double>(buf[1]) / buf[2];
+        counts[i] = static_cast<uint64_t>(buf[0] * scale);
+      } else {
+        counts[i] = buf[0];
+      }
+    }
+#endif
+  }
+
+  // Reports hardware event counts accumulated so far, as google-benchmark
+  // counters, averaged over `calls_per_iter` calls per benchmark iteration,
+  // along with IPC ( i.e. instructions per cycle ). Unavailable events are
+  // skipped.
+  inline void report(benchmark::State& state, const size_t calls_per_iter = 1)
+  {
+    read();
+
+    for (size_t i = 0; i < PERF_EVENT_CNT; i++) {
+      if (fds[i] < 0) {
+        continue;
+      }
+
+      const double v = static_cast<double>(counts[i]) / calls_per_iter;
+      state.counters[PERF_EVENT_NAMES[i]] =
+        benchmark::Counter(v, benchmark::Counter::kAvgIterations);
+    }
+
+    const auto insts = static_cast<size_t>(perf_event_t::instructions);
+    const auto cycs = static_cast<size_t>(perf_event_t::cycles);
+
+    if (fds[insts] >= 0 && fds[cycs] >= 0 && counts[cycs] != 0) {
+      const double ipc = static_cast<double>(counts[insts]) / counts[cycs];
+      state.counters["IPC"] = ipc;
+    }
+  }
+};
+
+}
@@ -1,4 +1,8 @@
 #pragma once
 
+#include "bench_ff.hpp"
 #include "bench_hasher.hpp"
 #include "bench_permutation.hpp"
+#include "bench_sparse_merkle_tree.hpp"
+#include "bench_stages.hpp"
+#include "bench_throughput.hpp"
@@ -0,0 +1,47 @@
+#pragma once
+#include "bench_common.hpp"
+#include "sparse_merkle_tree.hpp"
+
+// Benchmark Rescue Prime hash and its components, using google-benchmark
+namespace bench_rphash {
+
+// Benchmark batch update of N ( > 0 ) -many random keys of an empty 64 -level
+// sparse Merkle tree, using T ( > 0 ) -many threads
+inline void
+smt_update(benchmark::State& state)
+{
+  const size_t n = state.range(0);
+  const size_t nthreads = state.range(1);
+
+  std::vector<merkle::kv_t> kvs(n);
+  for (size_t i = 0; i < n; i++) {
+    kvs[i].first = ff::ff_t::random();
+    for (size_t j = 0; j < rescue::DIGEST_WIDTH; j++) {
+      kvs[i].second[j] = ff::ff_t::random();
+    }
+  }
+
+  latency_histogram_t latencies;
+  perf_counters_t perf;
+
+  perf.start();
+  for (auto _ : state) {
+    const auto t0 = std::chrono::high_resolution_clock::now();
+
+    merkle::sparse_merkle_tree_t<64> smt;
+
+    smt.update(kvs.data(), kvs.size(), nthreads);
+    benchmark::DoNotOptimize(smt);
+    benchmark::ClobberMemory();
+
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    latencies.record(std::chrono::duration_cast<nano_t>(t1 - t0).count());
+  }
+  perf.stop();
+
+  state.SetItemsProcessed(static_cast<int64_t>(n * state.iterations()));
+  latencies.report(state);
+  perf.report(state, n);
+}
+
+}
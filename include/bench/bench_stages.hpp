@@ -0,0 +1,114 @@
+#pragma once
+#include "bench_common.hpp"
+#include "permutation.hpp"
+#include "permutation_batch.hpp"
+
+// Benchmark Rescue Prime hash and its components, using google-benchmark
+namespace bench_rphash {
+
+// Benchmarks a stage of Rescue permutation, which mutates the state in place,
+// reporting wall time and cycles per call, labelled with compiled backend
+template<typename Stage>
+inline void
+permutation_stage(benchmark::State& state, Stage&& stage)
+{
+  alignas(32) ff::ff_t st[rescue::STATE_WIDTH];
+  for (size_t i = 0; i < rescue::STATE_WIDTH; i++) {
+    st[i] = ff::ff_t::random();
+  }
+
+  perf_counters_t perf;
+
+  perf.start();
+  const uint64_t c0 = cycles();
+  for (auto _ : state) {
+    stage(st);
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+  const uint64_t c1 = cycles();
+  perf.stop();
+
+  report_cycles(state, c1 - c0);
+  perf.report(state);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.SetLabel(backend());
+}
+
+// Benchmark S-Box stage of Rescue permutation
+inline void
+apply_sbox(benchmark::State& state)
+{
+  permutation_stage(state, [](ff::ff_t* st) { rescue::apply_sbox(st); });
+}
+
+// Benchmark inverse S-Box stage of Rescue permutation
+inline void
+apply_inv_sbox(benchmark::State& state)
+{
+  permutation_stage(state, [](ff::ff_t* st) { rescue::apply_inv_sbox(st); });
+}
+
+// Benchmark MDS matrix multiplication stage of Rescue permutation
+inline void
+apply_mds(benchmark::State& state)
+{
+  permutation_stage(state, [](ff::ff_t* st) { rescue::apply_mds(st); });
+}
+
+// Benchmark round constant addition stage, used in first half of each round
+inline void
+add_rc0(benchmark::State& state)
+{
+  permutation_stage(state, [](ff::ff_t* st) { rescue::add_rc0(st, 0); });
+}
+
+// Benchmark round constant addition stage, used in last half of each round
+inline void
+add_rc1(benchmark::State& state)
+{
+  permutation_stage(state, [](ff::ff_t* st) { rescue::add_rc1(st, 0); });
+}
+
+// Benchmark single round of Rescue permutation
+inline void
+apply_round(benchmark::State& state)
+{
+  permutation_stage(state, [](ff::ff_t* st) { rescue::apply_round(st, 0); });
+}
+
+// Benchmark batched Rescue permutation of N ( > 0 ) states, reporting cycles
+// spent per permuted state
+inline void
+permute_batch(benchmark::State& state)
+{
+  const size_t n = state.range();
+  std::vector<ff::ff_t> buf(n * rescue::STATE_WIDTH + 4);
+
+  // `std::vector` only guarantees 16 -bytes alignment
+  const auto addr = reinterpret_cast<uintptr_t>(buf.data());
+  auto* states = buf.data() + ((32 - (addr & 31)) & 31) / sizeof(ff::ff_t);
+
+  for (size_t i = 0; i < n * rescue::STATE_WIDTH; i++) {
+    states[i] = ff::ff_t::random();
+  }
+
+  perf_counters_t perf;
+
+  perf.start();
+  const uint64_t c0 = cycles();
+  for (auto _ : state) {
+    rescue::permute_batch(states, n);
+    benchmark::DoNotOptimize(states);
+    benchmark::ClobberMemory();
+  }
+  const uint64_t c1 = cycles();
+  perf.stop();
+
+  report_cycles(state, c1 - c0, n);
+  perf.report(state, n);
+  state.SetItemsProcessed(static_cast<int64_t>(n * state.iterations()));
+  state.SetLabel(backend());
+}
+
+}
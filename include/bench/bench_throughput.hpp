@@ -0,0 +1,317 @@
+#pragma once
+#include "aligned.hpp"
+#include "bench_common.hpp"
+#include "columnar.hpp"
+#include "ingest.hpp"
+#include "merkle_stream.hpp"
+#include "rescue_prime.hpp"
+#include "tree_hash.hpp"
+#include "xof.hpp"
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+// Benchmark Rescue Prime hash and its components, using google-benchmark
+namespace bench_rphash {
+
+// Benchmark sequential Rescue Prime hashing of N ( > 0 ) -bytes input, which
+// is interpreted as N/ 8 elements ∈ Z_q, reporting throughput in terms of
+// both bytes and elements processed per second
+inline void
+hash_throughput(benchmark::State& state)
+{
+  const size_t blen = state.range();
+  const size_t ilen = blen / sizeof(ff::ff_t);
+
+  const auto input = random_elements(ilen);
+  ff::ff_t output[rescue::DIGEST_WIDTH];
+
+  latency_histogram_t latencies;
+
+  for (auto _ : state) {
+    const auto t0 = std::chrono::high_resolution_clock::now();
+
+    rescue_prime::hash(input.data(), ilen, output);
+    benchmark::DoNotOptimize(output);
+    benchmark::ClobberMemory();
+
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    latencies.record(std::chrono::duration_cast<nano_t>(t1 - t0).count());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(blen * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(ilen * state.iterations()));
+  latencies.report(state);
+}
+
+// Benchmark sequential Rescue Prime hashing of N ( > 0 ) -bytes input, same as
+// `hash_throughput` does, but starting at an address which is offset by one
+// element from a 64 -bytes aligned one, so that none of the blocks is aligned
+// to SIMD register width
+inline void
+hash_misaligned_throughput(benchmark::State& state)
+{
+  const size_t blen = state.range();
+  const size_t ilen = blen / sizeof(ff::ff_t);
+
+  ff::aligned_vector_t<ff::ff_t> input(ilen + 1);
+  for (auto& v : input) {
+    v = ff::ff_t::random();
+  }
+  ff::ff_t output[rescue::DIGEST_WIDTH];
+
+  for (auto _ : state) {
+    rescue_prime::hash(input.data() + 1, ilen, output);
+    benchmark::DoNotOptimize(output);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(blen * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(ilen * state.iterations()));
+}
+
+// Benchmark squeezing M ( > 0 ) -many Z_q elements, from 64 -bytes seed ( i.e.
+// eight Z_q elements ), using sequential or counter mode extendable-output
+// function, reporting throughput in terms of both bytes and elements squeezed
+// per second
+template<const bool ctr_mode>
+inline void
+xof_throughput(benchmark::State& state)
+{
+  const size_t olen = state.range();
+
+  const auto seed = random_elements(rescue::RATE);
+  std::vector<ff::ff_t> output(olen);
+
+  for (auto _ : state) {
+    if constexpr (ctr_mode) {
+      rescue_prime::hash_xof_ctr(seed.data(), seed.size(), output.data(), olen);
+    } else {
+      rescue_prime::hash_xof(seed.data(), seed.size(), output.data(), olen);
+    }
+
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+
+  const size_t blen = olen * sizeof(ff::ff_t);
+  state.SetBytesProcessed(static_cast<int64_t>(blen * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(olen * state.iterations()));
+}
+
+// Benchmark tree mode Rescue Prime hashing of N ( > 0 ) -bytes input, which
+// is interpreted as N/ 8 elements ∈ Z_q, using T ( > 0 ) -many threads,
+// reporting throughput in terms of both bytes and elements processed per second
+inline void
+tree_hash_throughput(benchmark::State& state)
+{
+  const size_t blen = state.range(0);
+  const size_t nthreads = state.range(1);
+  const size_t ilen = blen / sizeof(ff::ff_t);
+
+  const auto input = random_elements(ilen);
+  ff::ff_t output[rescue::DIGEST_WIDTH];
+
+  latency_histogram_t latencies;
+
+  for (auto _ : state) {
+    const auto t0 = std::chrono::high_resolution_clock::now();
+
+    rescue_prime::tree_hash(input.data(), ilen, output, nthreads);
+    benchmark::DoNotOptimize(output);
+    benchmark::ClobberMemory();
+
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    latencies.record(std::chrono::duration_cast<nano_t>(t1 - t0).count());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(blen * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(ilen * state.iterations()));
+  latencies.report(state);
+}
+
+// Benchmark building binary Merkle tree of N ( > 0 ) -many leaves, where each
+// leaf is produced by hashing a row of eight Z_q elements, either by producing
+// all leaves before streaming them into the builder or by pipelining leaf
+// production with hashing, see `merkle::build_pipelined`, reporting throughput
+// in terms of leaves per second
+template<const bool pipelined>
+inline void
+merkle_stream(benchmark::State& state)
+{
+  constexpr size_t R = rescue::RATE;
+
+  const size_t n = state.range();
+  const auto rows = random_elements(n * R);
+
+  for (auto _ : state) {
+    size_t produced = 0;
+    auto produce = [&](merkle::digest_t* const dst, const size_t cap) {
+      const size_t len = std::min(cap, n - produced);
+      for (size_t i = 0; i < len; i++) {
+        const ff::ff_t* const row = rows.data() + (produced + i) * R;
+        rescue_prime::hash(row, R, dst[i].data());
+      }
+
+      produced += len;
+      return len;
+    };
+
+    merkle::digest_t root;
+    if constexpr (pipelined) {
+      root = merkle::build_pipelined(produce);
+    } else {
+      std::vector<merkle::digest_t> leaves(n);
+      produce(leaves.data(), n);
+
+      merkle::stream_builder_t builder;
+      builder.append(leaves.data(), n);
+      root = builder.finish();
+    }
+
+    benchmark::DoNotOptimize(root);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(n * state.iterations()));
+}
+
+// Benchmark Rescue Prime hashing of a file of N ( > 0 ) -bytes, holding raw
+// Z_q elements, which are ingested using given backend, so that reading next
+// block overlaps with absorbing previous one, reporting throughput in terms of
+// bytes processed per second
+template<ingest::backend_t backend>
+inline void
+hash_file_ingest(benchmark::State& state)
+{
+  const size_t blen = state.range();
+  const size_t ilen = blen / sizeof(ff::ff_t);
+
+  const auto path =
+    (std::filesystem::temp_directory_path() / "rphash_bench_ingest.bin")
+      .string();
+  {
+    const auto input = random_elements(ilen);
+    std::ofstream f{ path, std::ios::binary | std::ios::trunc };
+    f.write(reinterpret_cast<const char*>(input.data()),
+            static_cast<std::streamsize>(ilen * sizeof(ff::ff_t)));
+  }
+
+  ff::ff_t output[rescue::DIGEST_WIDTH];
+
+  for (auto _ : state) {
+    if (!ingest::hash_file(path, output, backend)) {
+      state.SkipWithError("failed to ingest input file");
+      break;
+    }
+
+    benchmark::DoNotOptimize(output);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(blen * state.iterations()));
+  std::filesystem::remove(path);
+}
+
+// Benchmark merging of a batch of B ( > 0 ) -many digest pairs, reporting
+// throughput in terms of merges per second and bytes of digests consumed
+// per second
+inline void
+merge_batch_throughput(benchmark::State& state)
+{
+  const size_t n = state.range();
+  constexpr size_t W = rescue::DIGEST_WIDTH;
+
+  const auto input = random_elements(2 * W * n);
+  std::vector<ff::ff_t> output(W * n);
+
+  latency_histogram_t latencies;
+
+  for (auto _ : state) {
+    const auto t0 = std::chrono::high_resolution_clock::now();
+
+    rescue_prime::merge_many(input.data(), n, output.data());
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    latencies.record(std::chrono::duration_cast<nano_t>(t1 - t0).count());
+  }
+
+  const size_t blen = input.size() * sizeof(ff::ff_t);
+  state.SetBytesProcessed(static_cast<int64_t>(blen * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(n * state.iterations()));
+  latencies.report(state);
+}
+
+// Adds benchmark arguments for all input sizes ∈ [1 KiB, 2^max_log2 bytes],
+// each being a power of 4, paired with all thread counts ∈ {1, 2, 4, ...},
+// capped at ( and always including ) number of available hardware threads
+inline void
+input_sizes_and_threads(benchmark::internal::Benchmark* b,
+                        const size_t max_log2)
+{
+  const size_t max_threads =
+    std::max<size_t>(1, std::thread::hardware_concurrency());
+
+  for (size_t log2 = 10; log2 <= max_log2; log2 += 2) {
+    const auto blen = static_cast<int64_t>(1ul << log2);
+
+    size_t t = 1;
+    for (; t < max_threads; t *= 2) {
+      b->Args({ blen, static_cast<int64_t>(t) });
+    }
+    b->Args({ blen, static_cast<int64_t>(max_threads) });
+  }
+}
+
+// Benchmark hashing rows of a column-major matrix of M ( > 0 ) -many rows and
+// N ( > 0 ) -many columns, either directly from columns, using cache-blocked
+// lane-parallel states, or by building a row-major copy of the matrix first and
+// then hashing each row, reporting throughput in terms of both bytes of matrix
+// and rows hashed per second
+template<const bool transpose>
+inline void
+hash_rows(benchmark::State& state)
+{
+  const size_t n_rows = state.range(0);
+  const size_t n_cols = state.range(1);
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+
+  std::vector<std::vector<ff::ff_t>> matrix(n_cols);
+  std::vector<const ff::ff_t*> columns(n_cols);
+  for (size_t c = 0; c < n_cols; c++) {
+    matrix[c] = random_elements(n_rows);
+    columns[c] = matrix[c].data();
+  }
+
+  std::vector<ff::ff_t> digests(n_rows * D);
+
+  for (auto _ : state) {
+    if constexpr (transpose) {
+      std::vector<ff::ff_t> rows(n_rows * n_cols);
+      for (size_t r = 0; r < n_rows; r++) {
+        for (size_t c = 0; c < n_cols; c++) {
+          rows[r * n_cols + c] = columns[c][r];
+        }
+      }
+
+      for (size_t r = 0; r < n_rows; r++) {
+        const ff::ff_t* const row = rows.data() + r * n_cols;
+        rescue_prime::hash(row, n_cols, digests.data() + r * D);
+      }
+    } else {
+      rescue_prime::hash_rows_columnar(
+        columns.data(), n_cols, n_rows, digests.data());
+    }
+
+    benchmark::DoNotOptimize(digests.data());
+    benchmark::ClobberMemory();
+  }
+
+  const size_t blen = n_rows * n_cols * sizeof(ff::ff_t);
+  state.SetBytesProcessed(static_cast<int64_t>(blen * state.iterations()));
+  state.SetItemsProcessed(static_cast<int64_t>(n_rows * state.iterations()));
+}
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "permutation_batch.hpp"
+#include "rescue_prime.hpp"
+
+// Rescue Prime Hashing over prime field Z_q, q = 2^64 - 2^32 + 1
+namespace rescue_prime {
+
+// Number of rows, whose permutation states are kept together ( lane-parallel ),
+// while absorbing a block of columns, see `hash_rows_columnar`. States of a
+// tile take 96 -bytes per row, while a block of columns take 64 -bytes per
+// row, so that both fit in L1 data cache.
+constexpr size_t COLUMNAR_TILE_ROWS = 64ul;
+
+// Given a matrix of Z_q elements, having N ( > 0 ) -many columns and M ( >= 0 )
+// -many rows, kept column-major ( i.e. one array of M elements per column ),
+// this routine computes Rescue Prime digest of each row, writing 4M -many
+// output elements, same as invoking `hash` on each row, without building a
+// row-major copy of the matrix.
+//
+// Rows are processed a tile of `COLUMNAR_TILE_ROWS` at a time, where states of
+// all rows of the tile are kept transposed i.e. lane-parallel ( see
+// `rescue::permute_lanes` ). Eight columns are absorbed at a time, by reading
+// the tile's segment of each column, which is contiguous in memory, into rate
+// portion of the states, before permuting them, so that each column is
+// streamed through exactly once. Columns need not be aligned.
+static inline void
+hash_rows_columnar(const ff::ff_t* const* const columns, // N columns
+                   const size_t n_cols, // number of columns
+                   const size_t n_rows, // number of rows
+                   ff::ff_t* const __restrict digests // 4M output elements
+)
+{
+  constexpr size_t W = rescue::STATE_WIDTH;
+  constexpr size_t L = rescue::BATCH_LANES;
+  constexpr size_t R = rescue::RATE;
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+  constexpr size_t T = COLUMNAR_TILE_ROWS;
+  constexpr size_t G = T / L;
+
+  static_assert(T % L == 0, "Tile must hold whole groups of lanes !");
+
+  instrument::bump(instrument::counter_t::hash, n_rows);
+  instrument::bump(instrument::counter_t::absorbed, n_rows * n_cols);
+
+  for (size_t r0 = 0; r0 < n_rows; r0 += T) {
+    const size_t rows = std::min(T, n_rows - r0);
+    const size_t groups = (rows + L - 1) / L;
+
+    rescue::lane_t states[G][W];
+    for (size_t g = 0; g < groups; g++) {
+      for (size_t j = 0; j < W; j++) {
+        states[g][j] = rescue::splat(ff::ff_t::zero());
+      }
+      states[g][rescue::CAPACITY_BEGINS] = rescue::splat(ff::ff_t{ n_cols });
+    }
+
+    // segment of a column, spanning rows of the tile, where missing rows of
+    // last tile are zero padded
+    alignas(32) ff::ff_t seg[T]{};
+
+    for (size_t c0 = 0; c0 < n_cols; c0 += R) {
+      const size_t cols = std::min(R, n_cols - c0);
+
+      for (size_t k = 0; k < cols; k++) {
+        const ff::ff_t* const col = columns[c0 + k] + r0;
+
+        // full tiles are read straight from the column, using unaligned
+        // loads, while last partial tile is staged, for zero padding
+        if (rows == T) {
+          for (size_t g = 0; g < groups; g++) {
+            auto& lane = states[g][rescue::RATE_BEGINS + k];
+            lane = lane + rescue::lane_t::load_unaligned(col + g * L);
+          }
+        } else {
+          std::memcpy(seg, col, rows * sizeof(ff::ff_t));
+
+          for (size_t g = 0; g < groups; g++) {
+            auto& lane = states[g][rescue::RATE_BEGINS + k];
+            lane = lane + rescue::lane_t{ seg + g * L };
+          }
+        }
+      }
+
+      for (size_t g = 0; g < groups; g++) {
+        rescue::permute_lanes(states[g]);
+      }
+    }
+
+    for (size_t g = 0; g < groups; g++) {
+      for (size_t d = 0; d < D; d++) {
+        alignas(32) ff::ff_t elms[L];
+        states[g][rescue::DIGEST_BEGINS + d].store(elms);
+
+        for (size_t l = 0; l < L && g * L + l < rows; l++) {
+          digests[(r0 + g * L + l) * D + d] = elms[l];
+        }
+      }
+    }
+  }
+}
+
+}
@@ -1,43 +1,73 @@
 #pragma once
+#include "instrument.hpp"
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <ostream>
 #include <random>
+#include <type_traits>
 #include <utility>
 
+#if defined __x86_64__
+#include <immintrin.h>
+#endif
+
 // Prime Field ( i.e. Z_q ) Arithmetic | q = 2^64 - 2^32 + 1
 namespace ff {
 
 // Prime Field Modulus
 constexpr uint64_t Q = 0xffffffff00000001ul;
 
+// Prime field modulus is of form 2^64 - ε, where ε = 2^32 - 1, so that 2^64 ≡ ε
+// ( mod q ), which is used for folding carries/ borrows and high limbs of
+// 128 -bit products back into 64 -bit limbs.
+constexpr uint64_t EPSILON = 0xfffffffful;
+
+// Scalar kernels, computing 128 -bit product of two 64 -bit unsigned integers,
+// one of which is selected during compilation, using `-DFF_MUL=<kernel>`
+// ( see `FF_MUL` variable in Makefile and `make tune` ), defaulting to the one
+// which performed best on targets benchmarked so far.
+//
+// - FF_MUL_SCHOOLBOOK : four 32x32 -> 64 -bit multiplications, portable
+// - FF_MUL_INT128     : compiler provided `unsigned __int128` multiplication
+// - FF_MUL_MULX       : `mulx` instruction, on x86_64 targets having BMI2
+//
+// If selected kernel is not available on target, it falls back to
+// FF_MUL_INT128, when compiler provides `unsigned __int128`, otherwise to
+// FF_MUL_SCHOOLBOOK.
+#define FF_MUL_SCHOOLBOOK 0
+#define FF_MUL_INT128 1
+#define FF_MUL_MULX 2
+
+// Scalar kernels, reducing 128 -bit product modulo q, one of which is selected
+// during compilation, using `-DFF_REDUCE=<kernel>`, same as `FF_MUL`.
+//
+// - FF_REDUCE_GENERIC : portable, comparison based carry/ borrow detection
+// - FF_REDUCE_ADX     : `_subborrow_u64`/ `_addcarry_u64` on x86_64 targets
+#define FF_REDUCE_GENERIC 0
+#define FF_REDUCE_ADX 1
+
+#if !defined FF_MUL
+#if __SIZEOF_INT128__ == 16
+#define FF_MUL FF_MUL_INT128
+#else
+#define FF_MUL FF_MUL_SCHOOLBOOK
+#endif
+#endif
+
+#if !defined FF_REDUCE
+#define FF_REDUCE FF_REDUCE_GENERIC
+#endif
+
 // Given two 64 -bit unsigned integer operands, this routine multiplies them
-// such that high and low 64 -bit limbs of 128 -bit result in accessible.
+// such that high and low 64 -bit limbs of 128 -bit result in accessible, using
+// four 32 -bit multiplications and additions, which works on any target.
 //
 // Note, returned pair holds high 64 -bits of result first and then remaining
 // low 64 -bits are kept.
 inline constexpr std::pair<uint64_t, uint64_t>
-full_mul_u64(const uint64_t lhs, const uint64_t rhs)
+full_mul_u64_schoolbook(const uint64_t lhs, const uint64_t rhs)
 {
-#if defined __aarch64__ && __SIZEOF_INT128__ == 16
-  // Benchmark results show that only on aarch64 CPU, if __int128 is supported
-  // by the compiler, it outperforms `else` code block, where manually high and
-  // low 64 -bit limbs are computed.
-
-  using uint128_t = unsigned __int128;
-
-  const auto a = static_cast<uint128_t>(lhs);
-  const auto b = static_cast<uint128_t>(rhs);
-  const auto c = a * b;
-
-  return std::make_pair(static_cast<uint64_t>(c >> 64),
-                        static_cast<uint64_t>(c));
-
-#else
-  // On x86_64 targets, following code block always performs better than above
-  // code block - as per benchmark results.
-
   const uint64_t lhs_hi = lhs >> 32;
   const uint64_t lhs_lo = lhs & 0xfffffffful;
 
@@ -65,8 +95,180 @@ full_mul_u64(const uint64_t lhs, const uint64_t rhs)
   const uint64_t res_lo = lo + (mid0_lo << 32) + (mid1_lo << 32);
 
   return std::make_pair(res_hi, res_lo);
+}
+
+// Given a 64 -bit unsigned integer, this routine squares it, such that high and
+// low 64 -bit limbs of 128 -bit result are accessible, same as
+// `full_mul_u64_schoolbook` does, but cross term of 32 -bit limbs is computed
+// only once and doubled, by shifting, requiring three multiplications instead
+// of four.
+inline constexpr std::pair<uint64_t, uint64_t>
+full_sqr_u64_schoolbook(const uint64_t a)
+{
+  const uint64_t a_hi = a >> 32;
+  const uint64_t a_lo = a & 0xfffffffful;
+
+  const uint64_t hh = a_hi * a_hi;
+  const uint64_t lh = a_lo * a_hi;
+  const uint64_t ll = a_lo * a_lo;
+
+  // a^2 = hh * 2^64 + lh * 2^33 + ll
+  const uint64_t t0 = lh + (ll >> 33);
+
+  const uint64_t res_hi = hh + (t0 >> 31);
+  const uint64_t res_lo = ll + (lh << 33);
+
+  return std::make_pair(res_hi, res_lo);
+}
+
+#if __SIZEOF_INT128__ == 16
+
+// Given two 64 -bit unsigned integer operands, this routine multiplies them
+// using compiler provided 128 -bit unsigned integer type, which is lowered to
+// single 64x64 -> 128 -bit multiply instruction ( or `mul`, `umulh` pair on
+// aarch64 ), returning high and low 64 -bit limbs, in order.
+inline constexpr std::pair<uint64_t, uint64_t>
+full_mul_u64_int128(const uint64_t lhs, const uint64_t rhs)
+{
+  __extension__ typedef unsigned __int128 uint128_t;
+
+  const auto a = static_cast<uint128_t>(lhs);
+  const auto b = static_cast<uint128_t>(rhs);
+  const auto c = a * b;
+
+  return std::make_pair(static_cast<uint64_t>(c >> 64),
+                        static_cast<uint64_t>(c));
+}
+
+#endif
+
+#if defined __x86_64__ && defined __BMI2__
+
+// Given two 64 -bit unsigned integer operands, this routine multiplies them
+// using BMI2 `mulx` instruction, which doesn't touch flags, so that it can be
+// freely scheduled along with carry chains of reduction, returning high and low
+// 64 -bit limbs, in order. During constant evaluation, it falls back to
+// `full_mul_u64_schoolbook`.
+inline constexpr std::pair<uint64_t, uint64_t>
+full_mul_u64_mulx(const uint64_t lhs, const uint64_t rhs)
+{
+  if (std::is_constant_evaluated()) {
+    return full_mul_u64_schoolbook(lhs, rhs);
+  }
+
+  unsigned long long hi = 0;
+  const unsigned long long lo = _mulx_u64(lhs, rhs, &hi);
+
+  return std::make_pair(static_cast<uint64_t>(hi), static_cast<uint64_t>(lo));
+}
 
 #endif
+
+// Given two 64 -bit unsigned integer operands, this routine multiplies them
+// such that high and low 64 -bit limbs of 128 -bit result in accessible, using
+// kernel selected by `FF_MUL`.
+//
+// Note, returned pair holds high 64 -bits of result first and then remaining
+// low 64 -bits are kept.
+inline constexpr std::pair<uint64_t, uint64_t>
+full_mul_u64(const uint64_t lhs, const uint64_t rhs)
+{
+#if FF_MUL == FF_MUL_MULX && defined __x86_64__ && defined __BMI2__
+  return full_mul_u64_mulx(lhs, rhs);
+#elif FF_MUL != FF_MUL_SCHOOLBOOK && __SIZEOF_INT128__ == 16
+  return full_mul_u64_int128(lhs, rhs);
+#else
+  return full_mul_u64_schoolbook(lhs, rhs);
+#endif
+}
+
+// Given a 64 -bit unsigned integer, this routine squares it, such that high and
+// low 64 -bit limbs of 128 -bit result are accessible, using kernel selected by
+// `FF_MUL`, where schoolbook kernel requires only three 32 -bit
+// multiplications, see `full_sqr_u64_schoolbook`.
+inline constexpr std::pair<uint64_t, uint64_t>
+full_sqr_u64(const uint64_t a)
+{
+#if FF_MUL == FF_MUL_MULX && defined __x86_64__ && defined __BMI2__
+  return full_mul_u64_mulx(a, a);
+#elif FF_MUL != FF_MUL_SCHOOLBOOK && __SIZEOF_INT128__ == 16
+  return full_mul_u64_int128(a, a);
+#else
+  return full_sqr_u64_schoolbook(a);
+#endif
+}
+
+// Given a 128 -bit unsigned integer, as its high and low 64 -bit limbs ( see
+// `full_mul_u64` ), this routine reduces it modulo q, returning a 64 -bit value
+// ∈ [0, 2^64), which is congruent to it, but not necessarily canonical, as
+// that's taken care of when constructing `ff_t` from it.
+inline constexpr uint64_t
+reduce128_generic(const uint64_t res_hi, const uint64_t res_lo)
+{
+  const uint64_t c = res_hi & 0xfffffffful;
+  const uint64_t d = res_hi >> 32;
+
+  const uint64_t t2 = res_lo - d;
+  const bool flg0 = res_lo < d;
+  const uint64_t t3 = static_cast<uint64_t>(-static_cast<uint32_t>(flg0));
+  const uint64_t t4 = t2 - t3;
+
+  const uint64_t t5 = (c << 32) - c;
+  const uint64_t t6 = t4 + t5;
+  const bool flg1 = t4 > UINT64_MAX - t5;
+  const uint64_t t7 = static_cast<uint64_t>(-static_cast<uint32_t>(flg1));
+  const uint64_t t8 = t6 + t7;
+
+  return t8;
+}
+
+#if defined __x86_64__
+
+// Given a 128 -bit unsigned integer, as its high and low 64 -bit limbs, this
+// routine reduces it modulo q, same as `reduce128_generic`, but borrow of
+// subtraction and carry of addition are taken from flags, using
+// `_subborrow_u64` and `_addcarry_u64`, and folded back without branching, as
+// 2^64 ≡ ε ( mod q ). During constant evaluation, it falls back to
+// `reduce128_generic`.
+inline constexpr uint64_t
+reduce128_adx(const uint64_t res_hi, const uint64_t res_lo)
+{
+  if (std::is_constant_evaluated()) {
+    return reduce128_generic(res_hi, res_lo);
+  }
+
+  const uint64_t c = res_hi & EPSILON;
+  const uint64_t d = res_hi >> 32;
+
+  // res_lo - d, where borrow ( i.e. -2^64 ) is fixed up by subtracting ε
+  unsigned long long t0 = 0;
+  const uint8_t brw = _subborrow_u64(0, res_lo, d, &t0);
+  t0 -= EPSILON & -static_cast<uint64_t>(brw);
+
+  // c * 2^64 ≡ c * ε ( mod q ), where carry ( i.e. 2^64 ) is fixed up by
+  // adding ε, which can't overflow again, as c * ε <= 2^64 - 2^33 + 1
+  unsigned long long t1 = 0;
+  const uint8_t cry = _addcarry_u64(0, t0, c * EPSILON, &t1);
+  t1 += EPSILON & -static_cast<uint64_t>(cry);
+
+  return static_cast<uint64_t>(t1);
+}
+
+#endif
+
+// Given a 128 -bit unsigned integer, as its high and low 64 -bit limbs ( see
+// `full_mul_u64` ), this routine reduces it modulo q, using kernel selected by
+// `FF_REDUCE`, returning a 64 -bit value ∈ [0, 2^64), which is congruent to it,
+// but not necessarily canonical, as that's taken care of when constructing
+// `ff_t` from it.
+inline constexpr uint64_t
+reduce128(const uint64_t res_hi, const uint64_t res_lo)
+{
+#if FF_REDUCE == FF_REDUCE_ADX && defined __x86_64__
+  return reduce128_adx(res_hi, res_lo);
+#else
+  return reduce128_generic(res_hi, res_lo);
+#endif
 }
 
 // An element of prime field Z_q | q = 2^64 - 2^32 + 1, with arithmetic
@@ -123,25 +325,33 @@ struct ff_t
   // are in canonical form
   inline constexpr ff_t operator*(const ff_t& rhs) const
   {
-    const auto res = full_mul_u64(this->v, rhs.v);
-    const uint64_t res_hi = res.first;
-    const uint64_t res_lo = res.second;
+    instrument::bump(instrument::counter_t::ff_mul);
 
-    const uint64_t c = res_hi & 0xfffffffful;
-    const uint64_t d = res_hi >> 32;
+    const auto [res_hi, res_lo] = full_mul_u64(this->v, rhs.v);
+    return ff_t{ reduce128(res_hi, res_lo) };
+  }
 
-    const uint64_t t2 = res_lo - d;
-    const bool flg0 = res_lo < d;
-    const uint64_t t3 = static_cast<uint64_t>(-static_cast<uint32_t>(flg0));
-    const uint64_t t4 = t2 - t3;
+  // Squaring over prime field, which is cheaper than multiplying an element by
+  // itself, see `full_sqr_u64`, such that both input and output are in
+  // canonical form
+  inline constexpr ff_t square() const
+  {
+    instrument::bump(instrument::counter_t::ff_mul);
 
-    const uint64_t t5 = (c << 32) - c;
-    const uint64_t t6 = t4 + t5;
-    const bool flg1 = t4 > UINT64_MAX - t5;
-    const uint64_t t7 = static_cast<uint64_t>(-static_cast<uint32_t>(flg1));
-    const uint64_t t8 = t6 + t7;
+    const auto [res_hi, res_lo] = full_sqr_u64(this->v);
+    return ff_t{ reduce128(res_hi, res_lo) };
+  }
 
-    return ff_t{ t8 };
+  // Squares an element k ( >= 0 ) -many times in a row i.e. raises it to
+  // 2^k -th power, keeping intermediate result in register
+  template<const size_t k>
+  inline constexpr ff_t square_n() const
+  {
+    ff_t res = *this;
+    for (size_t i = 0; i < k; i++) {
+      res = res.square();
+    }
+    return res;
   }
 
   // Raises an element of Z_q to N -th power ( which is a 64 -bit unsigned
@@ -153,6 +363,8 @@ struct ff_t
   // https://github.com/itzmeanjan/secp256k1/blob/6e5e654/field/scalar_field.py#L117-L127
   inline constexpr ff_t operator^(const size_t n) const
   {
+    instrument::bump(instrument::counter_t::ff_exp);
+
     const ff_t br[]{ ff_t::one(), *this };
     ff_t res = ff_t::one();
 
@@ -177,7 +389,11 @@ struct ff_t
   //
   // Adapted from
   // https://github.com/itzmeanjan/kyber/blob/3cd41a5/include/ff.hpp#L190-L216
-  inline constexpr ff_t inv() const { return *this ^ (Q - 2); }
+  inline constexpr ff_t inv() const
+  {
+    instrument::bump(instrument::counter_t::ff_inv);
+    return *this ^ (Q - 2);
+  }
 
   // Division over prime field Z_q
   inline constexpr ff_t operator/(const ff_t& rhs) const
@@ -7,6 +7,15 @@
 // Prime Field ( i.e. Z_q ) Arithmetic | q = 2^64 - 2^32 + 1
 namespace ff {
 
+// AVX2 only offers signed 64 -bit comparison, so for comparing unsigned 64 -bit
+// limbs, both operands are offset by 2^63 i.e. sign bit is flipped, which maps
+// [0, 2^64) to [-2^63, 2^63), preserving order.
+static inline __m256i
+shift(const __m256i a)
+{
+  return _mm256_xor_si256(a, _mm256_set1_epi64x(INT64_MIN));
+}
+
 // Given two 256 -bit registers, each holding four 64 -bit unsigned integers,
 // this routine computes whether a >= b.
 //
@@ -16,35 +25,26 @@ namespace ff {
 static inline __m256i
 gte(const __m256i a, const __m256i b)
 {
-  // To determine whether a > b | a, b ∈ [0, 2^64), it's enough to compare high
-  // 32 -bits of a, b.
-  //
-  // I've to choose this path due to the fact that `_mm256_cmpgt_epi64`
-  // intrinsic treats each 64 -bit limb to be a signed 64 -bit integer, which
-  // effectively rounds off operands and that ends up producing wrong comparison
-  // result, in a lot of cases.
-
-  const auto t0 = _mm256_srli_epi64(a, 32);
-  const auto t1 = _mm256_srli_epi64(b, 32);
+  // a >= b <=> !(b > a), compared after offsetting by 2^63, see `shift`
+  const auto t0 = _mm256_cmpgt_epi64(shift(b), shift(a));
+  const auto t1 = _mm256_xor_si256(t0, _mm256_set1_epi64x(-1));
 
-  const auto t2 = _mm256_cmpgt_epi64(t0, t1); // is > ?
-  const auto t3 = _mm256_cmpeq_epi64(a, b);   // is = ?
-  const auto t4 = _mm256_or_si256(t2, t3);    // is >= ?
-
-  return t4;
+  return t1;
 }
 
 // Given a 256 -bit register, holding four 64 -bit unsigned integers, this
 // routine converts each of those four limbs to their canonical representation
 // in prime field Z_q i.e. returned register holds four elements ∈ Z_q.
+//
+// Subtracting q from a limb ∈ [q, 2^64) is same as adding ε to it, modulo 2^64.
 static inline __m256i
 reduce(const __m256i a)
 {
-  const auto q = _mm256_set1_epi64x(ff::Q);
+  const auto qm1 = _mm256_set1_epi64x(ff::Q - 1ul);
 
-  const auto t0 = gte(a, q);
-  const auto t1 = _mm256_and_si256(t0, q);
-  const auto t2 = _mm256_sub_epi64(a, t1);
+  const auto t0 = _mm256_cmpgt_epi64(shift(a), shift(qm1)); // is >= q ?
+  const auto t1 = _mm256_and_si256(t0, _mm256_set1_epi64x(EPSILON));
+  const auto t2 = _mm256_add_epi64(a, t1);
 
   return t2;
 }
@@ -60,9 +60,11 @@ reduce(const __m256i a)
 // - high 64 -bits in first register
 // - then low 64 -bits are kept on second register
 //
-// This routine does exactly what
+// This routine does what
 // https://github.com/itzmeanjan/rescue-prime/blob/22b7aa5/include/ff.hpp#L15-L50
-// does, only difference is that it performs four of those operations at a time.
+// does, only difference is that it performs four of those operations at a time,
+// while accumulating partial products s.t. none of the additions overflow, so
+// that no carry needs to be computed.
 static inline std::pair<__m256i, __m256i>
 full_mul_u64x4(const __m256i lhs, const __m256i rhs)
 {
@@ -71,33 +73,75 @@ full_mul_u64x4(const __m256i lhs, const __m256i rhs)
   const auto lhs_hi = _mm256_srli_epi64(lhs, 32);
   const auto rhs_hi = _mm256_srli_epi64(rhs, 32);
 
-  const auto hi = _mm256_mul_epu32(lhs_hi, rhs_hi);
-  const auto mid0 = _mm256_mul_epu32(lhs_hi, rhs);
-  const auto mid1 = _mm256_mul_epu32(lhs, rhs_hi);
-  const auto lo = _mm256_mul_epu32(lhs, rhs);
+  const auto hh = _mm256_mul_epu32(lhs_hi, rhs_hi);
+  const auto hl = _mm256_mul_epu32(lhs_hi, rhs);
+  const auto lh = _mm256_mul_epu32(lhs, rhs_hi);
+  const auto ll = _mm256_mul_epu32(lhs, rhs);
 
-  const auto mid0_hi = _mm256_srli_epi64(mid0, 32);
-  const auto mid0_lo = _mm256_and_si256(mid0, u32x4);
-  const auto mid1_hi = _mm256_srli_epi64(mid1, 32);
-  const auto mid1_lo = _mm256_and_si256(mid1, u32x4);
+  // (2^32 - 1)^2 + (2^32 - 1) < 2^64, so none of these additions overflow
+  const auto t0 = _mm256_add_epi64(hl, _mm256_srli_epi64(ll, 32));
+  const auto t1 = _mm256_add_epi64(lh, _mm256_and_si256(t0, u32x4));
+  const auto t2 = _mm256_add_epi64(hh, _mm256_srli_epi64(t0, 32));
 
-  const auto t0 = _mm256_srli_epi64(lo, 32);
-  const auto t1 = _mm256_add_epi64(t0, mid0_lo);
-  const auto t2 = _mm256_add_epi64(t1, mid1_lo);
-  const auto carry = _mm256_srli_epi64(t2, 32);
+  const auto res_hi = _mm256_add_epi64(t2, _mm256_srli_epi64(t1, 32));
+  const auto t3 = _mm256_slli_epi64(t1, 32);
+  const auto res_lo = _mm256_blend_epi32(ll, t3, 0b10101010);
 
-  const auto t3 = _mm256_add_epi64(hi, mid0_hi);
-  const auto t4 = _mm256_add_epi64(t3, mid1_hi);
-  const auto res_hi = _mm256_add_epi64(t4, carry);
+  return std::make_pair(res_hi, res_lo);
+}
 
-  const auto t5 = _mm256_slli_epi64(mid0_lo, 32);
-  const auto t6 = _mm256_slli_epi64(mid1_lo, 32);
-  const auto t7 = _mm256_add_epi64(lo, t5);
-  const auto res_lo = _mm256_add_epi64(t7, t6);
+// Given a 256 -bit register, holding four 64 -bit unsigned integers, this
+// routine squares each of them, producing 128 -bit results, in same form as
+// `full_mul_u64x4` does, but cross term is computed only once and doubled, by
+// shifting, requiring three multiplications instead of four.
+static inline std::pair<__m256i, __m256i>
+full_sqr_u64x4(const __m256i a)
+{
+  const auto a_hi = _mm256_srli_epi64(a, 32);
+
+  const auto hh = _mm256_mul_epu32(a_hi, a_hi);
+  const auto lh = _mm256_mul_epu32(a, a_hi);
+  const auto ll = _mm256_mul_epu32(a, a);
+
+  // a^2 = hh * 2^64 + lh * 2^33 + ll
+  const auto t0 = _mm256_add_epi64(lh, _mm256_srli_epi64(ll, 33));
+
+  const auto res_hi = _mm256_add_epi64(hh, _mm256_srli_epi64(t0, 31));
+  const auto res_lo = _mm256_add_epi64(ll, _mm256_slli_epi64(lh, 33));
 
   return std::make_pair(res_hi, res_lo);
 }
 
+// Given four 128 -bit unsigned integers, as pair of 256 -bit registers, holding
+// high and low 64 -bits respectively ( see `full_mul_u64x4` ), this routine
+// reduces each of them modulo q, producing four elements ∈ Z_q.
+//
+// Say 128 -bit integer is hi_hi * 2^96 + hi_lo * 2^64 + lo, then using
+// 2^64 ≡ ε and 2^96 ≡ -1 ( mod q ), it's congruent to lo - hi_hi + hi_lo * ε,
+// where borrow/ carry of each step is folded back by subtracting/ adding ε.
+static inline __m256i
+reduce128(const __m256i hi, const __m256i lo)
+{
+  const auto eps = _mm256_set1_epi64x(EPSILON);
+
+  const auto hi_hi = _mm256_srli_epi64(hi, 32);
+  const auto hi_lo = _mm256_and_si256(hi, eps);
+
+  // lo - hi_hi, kept offset by 2^63
+  const auto lo_s = shift(lo);
+  const auto t0_s = _mm256_sub_epi64(lo_s, hi_hi);
+  const auto borrow = _mm256_cmpgt_epi64(t0_s, lo_s);
+  const auto t1_s = _mm256_sub_epi64(t0_s, _mm256_and_si256(borrow, eps));
+
+  // + hi_lo * ε, which is < 2^64
+  const auto t2 = _mm256_mul_epu32(hi_lo, eps);
+  const auto t3_s = _mm256_add_epi64(t1_s, t2);
+  const auto carry = _mm256_cmpgt_epi64(t1_s, t3_s);
+  const auto t4 = shift(_mm256_add_epi64(t3_s, _mm256_and_si256(carry, eps)));
+
+  return reduce(t4);
+}
+
 // Four elements of prime field Z_q | q = 2^64 - 2^32 + 1, stored in a 256 -bit
 // AVX2 register, loaded *only* from 32 -bytes aligned memory address ( see
 // constructor ), defining modular {addition, multiplication} over it.
@@ -105,6 +149,9 @@ struct ff_avx_t
 {
   __m256i v;
 
+  // Zero initialize a 256 -bit register
+  inline ff_avx_t() { v = _mm256_setzero_si256(); }
+
   // Assign a 256 -bit register
   inline constexpr ff_avx_t(const __m256i a) { v = a; }
 
@@ -117,6 +164,13 @@ struct ff_avx_t
     v = _mm256_load_si256((__m256i*)arr);
   }
 
+  // Load four 64 -bit unsigned integers from memory into a 256 -bit register,
+  // where starting memory address need not be aligned
+  static inline ff_avx_t load_unaligned(const ff::ff_t* const arr)
+  {
+    return ff_avx_t{ _mm256_loadu_si256((const __m256i*)arr) };
+  }
+
   // Given two 256 -bit registers, each holding 4 prime field Z_q elements, this
   // routine performs element wise addition over Z_q and returns result in
   // canonical form i.e. each 64 -bit result limb must ∈ Z_q.
@@ -127,20 +181,31 @@ struct ff_avx_t
   // time, it works on four of them.
   inline ff_avx_t operator+(const ff_avx_t& rhs) const
   {
-    const auto u64x4 = _mm256_set1_epi64x(UINT64_MAX);
-
     const auto t0 = _mm256_add_epi64(this->v, rhs.v);
-    const auto t1 = _mm256_sub_epi64(u64x4, rhs.v);
 
-    const auto t2 = _mm256_srli_epi64(this->v, 32);
-    const auto t3 = _mm256_srli_epi64(t1, 32);
-    const auto t4 = _mm256_cmpgt_epi64(t2, t3);
+    // carry out of 64 -bits ( i.e. 2^64 ) is folded back as ε
+    const auto t1 = _mm256_cmpgt_epi64(shift(this->v), shift(t0));
+    const auto t2 = _mm256_and_si256(t1, _mm256_set1_epi64x(EPSILON));
+    const auto t3 = _mm256_add_epi64(t0, t2);
+
+    const auto t4 = reduce(t3);
+    return ff_avx_t{ t4 };
+  }
 
-    const auto t5 = _mm256_srli_epi64(t4, 32);
-    const auto t6 = _mm256_add_epi64(t0, t5);
+  // Given two 256 -bit registers, each holding 4 prime field Z_q elements, this
+  // routine performs element wise subtraction over Z_q and returns result in
+  // canonical form i.e. each 64 -bit result limb must ∈ Z_q.
+  inline ff_avx_t operator-(const ff_avx_t& rhs) const
+  {
+    const auto t0 = _mm256_sub_epi64(this->v, rhs.v);
 
-    const auto t7 = reduce(t6);
-    return ff_avx_t{ t7 };
+    // borrow out of 64 -bits ( i.e. -2^64 ) is folded back as -ε, which keeps
+    // result canonical, as both operands are
+    const auto t1 = _mm256_cmpgt_epi64(shift(rhs.v), shift(this->v));
+    const auto t2 = _mm256_and_si256(t1, _mm256_set1_epi64x(EPSILON));
+    const auto t3 = _mm256_sub_epi64(t0, t2);
+
+    return ff_avx_t{ t3 };
   }
 
   // Given two 256 -bit registers, each holding 4 prime field Z_q elements, this
@@ -153,36 +218,29 @@ struct ff_avx_t
   // time, it works on four of them.
   inline ff_avx_t operator*(const ff_avx_t& rhs) const
   {
-    const auto u32x4 = _mm256_set1_epi64x(UINT32_MAX);
-    const auto u64x4 = _mm256_set1_epi64x(UINT64_MAX);
-
-    const auto res = full_mul_u64x4(this->v, rhs.v);
-    const auto res_hi = res.first;
-    const auto res_lo = res.second;
-
-    const auto c = _mm256_and_si256(res_hi, u32x4);
-    const auto d = _mm256_srli_epi64(res_hi, 32);
-
-    const auto t2 = _mm256_sub_epi64(res_lo, d);
-    const auto t3 = _mm256_srli_epi64(res_lo, 32);
-    const auto t4 = _mm256_srli_epi64(d, 32);
-    const auto t5 = _mm256_cmpgt_epi64(t4, t3);
-    const auto t6 = _mm256_srli_epi64(t5, 32);
-    const auto t7 = _mm256_sub_epi64(t2, t6);
-
-    const auto t8 = _mm256_slli_epi64(c, 32);
-    const auto t9 = _mm256_sub_epi64(t8, c);
-    const auto t10 = _mm256_add_epi64(t7, t9);
-
-    const auto t11 = _mm256_sub_epi64(u64x4, t9);
-    const auto t12 = _mm256_srli_epi64(t7, 32);
-    const auto t13 = _mm256_srli_epi64(t11, 32);
-    const auto t14 = _mm256_cmpgt_epi64(t12, t13);
-    const auto t15 = _mm256_srli_epi64(t14, 32);
-    const auto t16 = _mm256_add_epi64(t10, t15);
-
-    const auto t17 = reduce(t16);
-    return ff_avx_t{ t17 };
+    const auto [hi, lo] = full_mul_u64x4(this->v, rhs.v);
+    return ff_avx_t{ reduce128(hi, lo) };
+  }
+
+  // Squares each of four prime field Z_q elements, which is cheaper than
+  // multiplying them by themselves, as it needs three 32x32 -bit
+  // multiplications instead of four, see `full_sqr_u64x4`.
+  inline ff_avx_t square() const
+  {
+    const auto [hi, lo] = full_sqr_u64x4(this->v);
+    return ff_avx_t{ reduce128(hi, lo) };
+  }
+
+  // Squares each element k ( >= 0 ) -many times in a row i.e. raises them to
+  // 2^k -th power, keeping intermediate result in register
+  template<const size_t k>
+  inline ff_avx_t square_n() const
+  {
+    auto res = *this;
+    for (size_t i = 0; i < k; i++) {
+      res = res.square();
+    }
+    return res;
   }
 
   // Stores four prime field Z_q elements ( kept in a 256 -bit register ) into
@@ -193,6 +251,13 @@ struct ff_avx_t
   {
     _mm256_store_si256((__m256i*)arr, this->v);
   }
+
+  // Stores four prime field Z_q elements ( kept in a 256 -bit register ) into
+  // memory, where starting memory address need not be aligned
+  inline void store_unaligned(ff::ff_t* const arr) const
+  {
+    _mm256_storeu_si256((__m256i*)arr, this->v);
+  }
 };
 
 }
@@ -10,16 +10,18 @@ namespace ff {
 // Given a 512 -bit register, holding eight 64 -bit unsigned integers, this
 // routine converts each of those eight limbs to their canonical representation
 // in prime field Z_q i.e. returned register holds eight elements ∈ Z_q.
+//
+// Subtracting q from a limb ∈ [q, 2^64) is same as adding ε to it, modulo 2^64.
 static inline __m512i
 reduce(const __m512i a)
 {
   const auto q = _mm512_set1_epi64(ff::Q);
+  const auto eps = _mm512_set1_epi64(EPSILON);
 
-  const auto t0 = _mm512_cmpgt_epu64_mask(a, q);
-  const auto t1 = _mm512_maskz_set1_epi64(t0, ff::Q);
-  const auto t2 = _mm512_sub_epi64(a, t1);
+  const auto t0 = _mm512_cmpge_epu64_mask(a, q);
+  const auto t1 = _mm512_mask_add_epi64(a, t0, a, eps);
 
-  return t2;
+  return t1;
 }
 
 // Given two 512 -bit registers, each holding eight 64 -bit unsigned integers,
@@ -45,33 +47,72 @@ full_mul_u64x8(const __m512i lhs, const __m512i rhs)
   const auto lhs_hi = _mm512_srli_epi64(lhs, 32);
   const auto rhs_hi = _mm512_srli_epi64(rhs, 32);
 
-  const auto hi = _mm512_mul_epu32(lhs_hi, rhs_hi);
-  const auto mid0 = _mm512_mul_epu32(lhs_hi, rhs);
-  const auto mid1 = _mm512_mul_epu32(lhs, rhs_hi);
-  const auto lo = _mm512_mul_epu32(lhs, rhs);
+  const auto hh = _mm512_mul_epu32(lhs_hi, rhs_hi);
+  const auto hl = _mm512_mul_epu32(lhs_hi, rhs);
+  const auto lh = _mm512_mul_epu32(lhs, rhs_hi);
+  const auto ll = _mm512_mul_epu32(lhs, rhs);
+
+  // (2^32 - 1)^2 + (2^32 - 1) < 2^64, so none of these additions overflow
+  const auto t0 = _mm512_add_epi64(hl, _mm512_srli_epi64(ll, 32));
+  const auto t1 = _mm512_add_epi64(lh, _mm512_and_si512(t0, u32x8));
+  const auto t2 = _mm512_add_epi64(hh, _mm512_srli_epi64(t0, 32));
+
+  const auto res_hi = _mm512_add_epi64(t2, _mm512_srli_epi64(t1, 32));
+  const auto t3 = _mm512_slli_epi64(t1, 32);
+  const auto res_lo = _mm512_mask_blend_epi32(0b1010101010101010, ll, t3);
+
+  return std::make_pair(res_hi, res_lo);
+}
 
-  const auto mid0_hi = _mm512_srli_epi64(mid0, 32);
-  const auto mid0_lo = _mm512_and_si512(mid0, u32x8);
-  const auto mid1_hi = _mm512_srli_epi64(mid1, 32);
-  const auto mid1_lo = _mm512_and_si512(mid1, u32x8);
+// Given a 512 -bit register, holding eight 64 -bit unsigned integers, this
+// routine squares each of them, producing 128 -bit results, in same form as
+// `full_mul_u64x8` does, but cross term is computed only once and doubled, by
+// shifting, requiring three multiplications instead of four.
+static inline std::pair<__m512i, __m512i>
+full_sqr_u64x8(const __m512i a)
+{
+  const auto a_hi = _mm512_srli_epi64(a, 32);
 
-  const auto t0 = _mm512_srli_epi64(lo, 32);
-  const auto t1 = _mm512_add_epi64(t0, mid0_lo);
-  const auto t2 = _mm512_add_epi64(t1, mid1_lo);
-  const auto carry = _mm512_srli_epi64(t2, 32);
+  const auto hh = _mm512_mul_epu32(a_hi, a_hi);
+  const auto lh = _mm512_mul_epu32(a, a_hi);
+  const auto ll = _mm512_mul_epu32(a, a);
 
-  const auto t3 = _mm512_add_epi64(hi, mid0_hi);
-  const auto t4 = _mm512_add_epi64(t3, mid1_hi);
-  const auto res_hi = _mm512_add_epi64(t4, carry);
+  // a^2 = hh * 2^64 + lh * 2^33 + ll
+  const auto t0 = _mm512_add_epi64(lh, _mm512_srli_epi64(ll, 33));
 
-  const auto t5 = _mm512_slli_epi64(mid0_lo, 32);
-  const auto t6 = _mm512_slli_epi64(mid1_lo, 32);
-  const auto t7 = _mm512_add_epi64(lo, t5);
-  const auto res_lo = _mm512_add_epi64(t7, t6);
+  const auto res_hi = _mm512_add_epi64(hh, _mm512_srli_epi64(t0, 31));
+  const auto res_lo = _mm512_add_epi64(ll, _mm512_slli_epi64(lh, 33));
 
   return std::make_pair(res_hi, res_lo);
 }
 
+// Given eight 128 -bit unsigned integers, as pair of 512 -bit registers,
+// holding high and low 64 -bits respectively ( see `full_mul_u64x8` ), this
+// routine reduces each of them modulo q, producing eight elements ∈ Z_q.
+//
+// Say 128 -bit integer is hi_hi * 2^96 + hi_lo * 2^64 + lo, then using
+// 2^64 ≡ ε and 2^96 ≡ -1 ( mod q ), it's congruent to lo - hi_hi + hi_lo * ε,
+// where borrow/ carry of each step is folded back by subtracting/ adding ε.
+static inline __m512i
+reduce128(const __m512i hi, const __m512i lo)
+{
+  const auto eps = _mm512_set1_epi64(EPSILON);
+
+  const auto hi_hi = _mm512_srli_epi64(hi, 32);
+  const auto hi_lo = _mm512_and_si512(hi, eps);
+
+  const auto t0 = _mm512_sub_epi64(lo, hi_hi);
+  const auto borrow = _mm512_cmpgt_epu64_mask(hi_hi, lo);
+  const auto t1 = _mm512_mask_sub_epi64(t0, borrow, t0, eps);
+
+  const auto t2 = _mm512_mul_epu32(hi_lo, eps);
+  const auto t3 = _mm512_add_epi64(t1, t2);
+  const auto carry = _mm512_cmpgt_epu64_mask(t1, t3);
+  const auto t4 = _mm512_mask_add_epi64(t3, carry, t3, eps);
+
+  return reduce(t4);
+}
+
 // Eight elements of the prime field Z_q | q = 2^64 - 2^32 + 1, stored in a 512
 // -bit AVX512 register, loaded *only* from 64 -bytes aligned memory address (
 // see constructor ), defining modular {addition, multiplication} over it, used
@@ -80,6 +121,9 @@ struct ff_avx512_t
 {
   __m512i v;
 
+  // Zero initialize a 512 -bit register
+  inline ff_avx512_t() { v = _mm512_setzero_si512(); }
+
   // Assign a 512 -bit register
   inline constexpr ff_avx512_t(const __m512i a) { v = a; }
 
@@ -89,6 +133,13 @@ struct ff_avx512_t
   // result in a segmentation fault.
   inline ff_avx512_t(const ff::ff_t* const arr) { v = _mm512_load_epi64(arr); }
 
+  // Load eight 64 -bit unsigned integers from memory into a 512 -bit register,
+  // where starting memory address need not be aligned
+  static inline ff_avx512_t load_unaligned(const ff::ff_t* const arr)
+  {
+    return ff_avx512_t{ _mm512_loadu_si512(arr) };
+  }
+
   // Given two 512 -bit registers, each holding eight prime field Z_q elements,
   // this routine performs element wise addition over Z_q and returns result in
   // canonical form i.e. each 64 -bit result limb must ∈ Z_q.
@@ -99,16 +150,31 @@ struct ff_avx512_t
   // time, it works on eight of them.
   inline ff_avx512_t operator+(const ff_avx512_t& rhs) const
   {
-    const auto u64x8 = _mm512_set1_epi64(UINT64_MAX);
+    const auto eps = _mm512_set1_epi64(EPSILON);
 
+    // carry out of 64 -bits ( i.e. 2^64 ) is folded back as ε
     const auto t0 = _mm512_add_epi64(this->v, rhs.v);
-    const auto t1 = _mm512_sub_epi64(u64x8, rhs.v);
-    const auto t2 = _mm512_cmpgt_epu64_mask(this->v, t1);
-    const auto t3 = _mm512_maskz_set1_epi64(t2, UINT32_MAX);
-    const auto t4 = _mm512_add_epi64(t0, t3);
+    const auto t1 = _mm512_cmpgt_epu64_mask(this->v, t0);
+    const auto t2 = _mm512_mask_add_epi64(t0, t1, t0, eps);
+
+    const auto t3 = reduce(t2);
+    return ff_avx512_t{ t3 };
+  }
+
+  // Given two 512 -bit registers, each holding eight prime field Z_q elements,
+  // this routine performs element wise subtraction over Z_q and returns result
+  // in canonical form i.e. each 64 -bit result limb must ∈ Z_q.
+  inline ff_avx512_t operator-(const ff_avx512_t& rhs) const
+  {
+    const auto eps = _mm512_set1_epi64(EPSILON);
+
+    // borrow out of 64 -bits ( i.e. -2^64 ) is folded back as -ε, which keeps
+    // result canonical, as both operands are
+    const auto t0 = _mm512_sub_epi64(this->v, rhs.v);
+    const auto t1 = _mm512_cmpgt_epu64_mask(rhs.v, this->v);
+    const auto t2 = _mm512_mask_sub_epi64(t0, t1, t0, eps);
 
-    const auto t5 = reduce(t4);
-    return ff_avx512_t{ t5 };
+    return ff_avx512_t{ t2 };
   }
 
   // Given two 512 -bit registers, each holding 8 prime field Z_q elements, this
@@ -121,30 +187,29 @@ struct ff_avx512_t
   // time, it works on eight of them.
   inline ff_avx512_t operator*(const ff_avx512_t& rhs) const
   {
-    const auto u32x8 = _mm512_set1_epi64(UINT32_MAX);
-    const auto u64x8 = _mm512_set1_epi64(UINT64_MAX);
-
-    const auto [res_hi, res_lo] = full_mul_u64x8(this->v, rhs.v);
-
-    const auto c = _mm512_and_si512(res_hi, u32x8);
-    const auto d = _mm512_srli_epi64(res_hi, 32);
-
-    const auto t2 = _mm512_sub_epi64(res_lo, d);
-    const auto t3 = _mm512_cmpgt_epu64_mask(d, res_lo);
-    const auto t4 = _mm512_maskz_set1_epi64(t3, UINT32_MAX);
-    const auto t5 = _mm512_sub_epi64(t2, t4);
-
-    const auto t6 = _mm512_slli_epi64(c, 32);
-    const auto t7 = _mm512_sub_epi64(t6, c);
-    const auto t8 = _mm512_add_epi64(t5, t7);
+    const auto [hi, lo] = full_mul_u64x8(this->v, rhs.v);
+    return ff_avx512_t{ reduce128(hi, lo) };
+  }
 
-    const auto t9 = _mm512_sub_epi64(u64x8, t7);
-    const auto t10 = _mm512_cmpgt_epu64_mask(t5, t9);
-    const auto t11 = _mm512_maskz_set1_epi64(t10, UINT32_MAX);
-    const auto t12 = _mm512_add_epi64(t8, t11);
+  // Squares each of eight prime field Z_q elements, which is cheaper than
+  // multiplying them by themselves, as it needs three 32x32 -bit
+  // multiplications instead of four, see `full_sqr_u64x8`.
+  inline ff_avx512_t square() const
+  {
+    const auto [hi, lo] = full_sqr_u64x8(this->v);
+    return ff_avx512_t{ reduce128(hi, lo) };
+  }
 
-    const auto t13 = reduce(t12);
-    return ff_avx512_t{ t13 };
+  // Squares each element k ( >= 0 ) -many times in a row i.e. raises them to
+  // 2^k -th power, keeping intermediate result in register
+  template<const size_t k>
+  inline ff_avx512_t square_n() const
+  {
+    auto res = *this;
+    for (size_t i = 0; i < k; i++) {
+      res = res.square();
+    }
+    return res;
   }
 
   // Stores eight prime field Z_q elements ( kept in a 512 -bit register ) into
@@ -156,6 +221,13 @@ struct ff_avx512_t
   {
     _mm512_store_epi64(arr, this->v);
   }
+
+  // Stores eight prime field Z_q elements ( kept in a 512 -bit register ) into
+  // memory, where starting memory address need not be aligned
+  inline void store_unaligned(ff::ff_t* const arr) const
+  {
+    _mm512_storeu_si512(arr, this->v);
+  }
 };
 
 }
@@ -0,0 +1,503 @@
+#pragma once
+#include "ff.hpp"
+#include "ff_avx.hpp"
+#include "ff_avx512.hpp"
+#include <type_traits>
+
+// Extension Field Arithmetic over prime field Z_q | q = 2^64 - 2^32 + 1
+//
+// STARK provers draw out-of-domain challenges and run FRI over an extension of
+// Z_q, because Z_q alone is too small for the required soundness. Following
+// ones are defined, same as winterfell does
+//
+// - F_q2 = Z_q[φ] / (φ^2 - φ + 2)
+// - F_q3 = Z_q[φ] / (φ^3 - φ - 1)
+//
+// Elements are kept as coefficients over basis {1, φ} or {1, φ, φ^2}, where
+// each coefficient is of type F, which is `ff_t` for scalar elements, while
+// it's `ff_avx_t`/ `ff_avx512_t` for four/ eight elements, held coefficient
+// wise in SIMD registers, see batched kernels below.
+namespace ff {
+
+// Element of quadratic extension Z_q[φ] / (φ^2 - φ + 2), with coefficients of
+// type F, defining arithmetic operations over it
+template<typename F>
+struct ext2_t
+{
+  // Extension degree i.e. number of coefficients
+  static constexpr size_t DEGREE = 2;
+
+  // Same extension element, with coefficients of another type
+  template<typename G>
+  using rebind_t = ext2_t<G>;
+
+  F c[DEGREE]{};
+
+  inline constexpr ext2_t() = default;
+
+  // Given coefficients, returns a0 + a1 * φ; so that an element of base field
+  // is embedded as a0 + 0 * φ
+  inline constexpr ext2_t(const F a0, const F a1 = F{})
+    : c{ a0, a1 }
+  {
+  }
+
+  // Generate extension field element having value 0
+  static inline constexpr ext2_t zero() { return ext2_t{}; }
+
+  // Generate extension field element having value 1
+  static inline constexpr ext2_t one() { return ext2_t{ ff_t::one() }; }
+
+  // Coefficient wise addition over extension field
+  inline constexpr ext2_t operator+(const ext2_t& rhs) const
+  {
+    return ext2_t{ c[0] + rhs.c[0], c[1] + rhs.c[1] };
+  }
+
+  // Coefficient wise subtraction over extension field
+  inline constexpr ext2_t operator-(const ext2_t& rhs) const
+  {
+    return ext2_t{ c[0] - rhs.c[0], c[1] - rhs.c[1] };
+  }
+
+  // Coefficient wise negation over extension field
+  inline constexpr ext2_t operator-() const { return ext2_t{ -c[0], -c[1] }; }
+
+  // Multiplication over extension field, using Karatsuba, requiring three
+  // multiplications over base field instead of four.
+  //
+  // (a0 + a1φ)(b0 + b1φ) = a0b0 + (a0b1 + a1b0)φ + a1b1φ^2, where φ^2 = φ - 2,
+  // so that result is (a0b0 - 2a1b1) + ((a0 + a1)(b0 + b1) - a0b0)φ
+  inline constexpr ext2_t operator*(const ext2_t& rhs) const
+  {
+    const F z0 = c[0] * rhs.c[0];
+    const F z2 = c[1] * rhs.c[1];
+    const F z1 = (c[0] + c[1]) * (rhs.c[0] + rhs.c[1]);
+
+    return ext2_t{ z0 - (z2 + z2), z1 - z0 };
+  }
+
+  // Multiplication of an extension field element by a base field element
+  inline constexpr ext2_t operator*(const F& rhs) const
+  {
+    return ext2_t{ c[0] * rhs, c[1] * rhs };
+  }
+
+  // Squaring over extension field, which is cheaper than multiplying an
+  // element by itself, as it needs two squarings and one multiplication over
+  // base field
+  //
+  // (a0 + a1φ)^2 = (a0^2 - 2a1^2) + (2a0a1 + a1^2)φ
+  inline constexpr ext2_t square() const
+  {
+    const F z0 = c[0].square();
+    const F z2 = c[1].square();
+    const F z1 = c[0] * c[1];
+
+    return ext2_t{ z0 - (z2 + z2), (z1 + z1) + z2 };
+  }
+
+  // Frobenius endomorphism i.e. raises an element to q -th power, which maps φ
+  // to other root of φ^2 - φ + 2 i.e. 1 - φ, hence it's conjugation
+  inline constexpr ext2_t frobenius() const
+  {
+    return ext2_t{ c[0] + c[1], -c[1] };
+  }
+
+  // Norm of an extension field element, over base field, which is product of
+  // it and its conjugate i.e. a0^2 + a0a1 + 2a1^2
+  inline constexpr F norm() const
+  {
+    const F t0 = c[0] * (c[0] + c[1]);
+    const F t1 = c[1].square();
+
+    return t0 + (t1 + t1);
+  }
+
+  // Multiplicative inverse over extension field, computed as conjugate divided
+  // by norm, requiring single inversion over base field. When input is 0,
+  // inverse can't be computed, hence return value is 0.
+  inline constexpr ext2_t inv() const { return frobenius() * norm().inv(); }
+
+  // Division over extension field
+  inline constexpr ext2_t operator/(const ext2_t& rhs) const
+  {
+    return *this * rhs.inv();
+  }
+
+  // Raises an extension field element to N -th power ( which is a 64 -bit
+  // unsigned integer ), using exponentiation by repeated squaring rule
+  inline constexpr ext2_t operator^(const size_t n) const
+  {
+    const ext2_t br[]{ one(), *this };
+    ext2_t res = one();
+
+    for (size_t i = 0; i < 64; i++) {
+      res = res.square();
+
+      const size_t bidx = 63 - i;
+      res = res * br[(n >> bidx) & 0b1ul];
+    }
+
+    return res;
+  }
+
+  // Check equality of two extension field elements
+  inline constexpr bool operator==(const ext2_t& rhs) const
+  {
+    return (c[0] == rhs.c[0]) & (c[1] == rhs.c[1]);
+  }
+
+  // Check inequality of two extension field elements
+  inline constexpr bool operator!=(const ext2_t& rhs) const
+  {
+    return !(*this == rhs);
+  }
+
+  // Generate a random extension field element
+  static inline ext2_t random()
+  {
+    return ext2_t{ ff_t::random(), ff_t::random() };
+  }
+};
+
+// Element of cubic extension Z_q[φ] / (φ^3 - φ - 1), with coefficients of type
+// F, defining arithmetic operations over it
+template<typename F>
+struct ext3_t
+{
+  // Extension degree i.e. number of coefficients
+  static constexpr size_t DEGREE = 3;
+
+  // Same extension element, with coefficients of another type
+  template<typename G>
+  using rebind_t = ext3_t<G>;
+
+  F c[DEGREE]{};
+
+  inline constexpr ext3_t() = default;
+
+  // Given coefficients, returns a0 + a1 * φ + a2 * φ^2; so that an element of
+  // base field is embedded as a0 + 0 * φ + 0 * φ^2
+  inline constexpr ext3_t(const F a0, const F a1 = F{}, const F a2 = F{})
+    : c{ a0, a1, a2 }
+  {
+  }
+
+  // Generate extension field element having value 0
+  static inline constexpr ext3_t zero() { return ext3_t{}; }
+
+  // Generate extension field element having value 1
+  static inline constexpr ext3_t one() { return ext3_t{ ff_t::one() }; }
+
+  // Coefficient wise addition over extension field
+  inline constexpr ext3_t operator+(const ext3_t& rhs) const
+  {
+    return ext3_t{ c[0] + rhs.c[0], c[1] + rhs.c[1], c[2] + rhs.c[2] };
+  }
+
+  // Coefficient wise subtraction over extension field
+  inline constexpr ext3_t operator-(const ext3_t& rhs) const
+  {
+    return ext3_t{ c[0] - rhs.c[0], c[1] - rhs.c[1], c[2] - rhs.c[2] };
+  }
+
+  // Coefficient wise negation over extension field
+  inline constexpr ext3_t operator-() const
+  {
+    return ext3_t{ -c[0], -c[1], -c[2] };
+  }
+
+  // Multiplication over extension field, using Karatsuba, requiring six
+  // multiplications over base field instead of nine.
+  //
+  // Product of two degree-2 polynomials is d0 + d1φ + d2φ^2 + d3φ^3 + d4φ^4,
+  // where φ^3 = φ + 1 and φ^4 = φ^2 + φ, so that result is
+  // (d0 + d3) + (d1 + d3 + d4)φ + (d2 + d4)φ^2
+  inline constexpr ext3_t operator*(const ext3_t& rhs) const
+  {
+    const F m0 = c[0] * rhs.c[0];
+    const F m1 = c[1] * rhs.c[1];
+    const F m2 = c[2] * rhs.c[2];
+
+    const F m01 = (c[0] + c[1]) * (rhs.c[0] + rhs.c[1]);
+    const F m02 = (c[0] + c[2]) * (rhs.c[0] + rhs.c[2]);
+    const F m12 = (c[1] + c[2]) * (rhs.c[1] + rhs.c[2]);
+
+    const F d1 = m01 - (m0 + m1);
+    const F d2 = (m02 - (m0 + m2)) + m1;
+    const F d3 = m12 - (m1 + m2);
+
+    return ext3_t{ m0 + d3, d1 + (d3 + m2), d2 + m2 };
+  }
+
+  // Multiplication of an extension field element by a base field element
+  inline constexpr ext3_t operator*(const F& rhs) const
+  {
+    return ext3_t{ c[0] * rhs, c[1] * rhs, c[2] * rhs };
+  }
+
+  // Squaring over extension field, which is cheaper than multiplying an
+  // element by itself, as it needs three squarings and three multiplications
+  // over base field, see `operator*` for how result is reduced
+  inline constexpr ext3_t square() const
+  {
+    const F s0 = c[0].square();
+    const F s2 = c[2].square();
+
+    const F t01 = c[0] * c[1];
+    const F t02 = c[0] * c[2];
+    const F t12 = c[1] * c[2];
+
+    const F d1 = t01 + t01;
+    const F d2 = (t02 + t02) + c[1].square();
+    const F d3 = t12 + t12;
+
+    return ext3_t{ s0 + d3, d1 + (d3 + s2), d2 + s2 };
+  }
+
+  // Raises an extension field element to q^k -th power | k ∈ {0, 1, 2}, see
+  // definition below, where constants are known
+  template<const size_t k>
+  inline constexpr ext3_t frobenius() const;
+
+  // Norm of an extension field element, over base field, which is product of
+  // it and its two conjugates
+  inline constexpr F norm() const
+  {
+    const ext3_t t = frobenius<1>() * frobenius<2>();
+    return (*this * t).c[0];
+  }
+
+  // Multiplicative inverse over extension field, computed as product of two
+  // conjugates divided by norm, requiring single inversion over base field.
+  // When input is 0, inverse can't be computed, hence return value is 0.
+  inline constexpr ext3_t inv() const
+  {
+    const ext3_t t = frobenius<1>() * frobenius<2>();
+    const F n = (*this * t).c[0];
+
+    return t * n.inv();
+  }
+
+  // Division over extension field
+  inline constexpr ext3_t operator/(const ext3_t& rhs) const
+  {
+    return *this * rhs.inv();
+  }
+
+  // Raises an extension field element to N -th power ( which is a 64 -bit
+  // unsigned integer ), using exponentiation by repeated squaring rule
+  inline constexpr ext3_t operator^(const size_t n) const
+  {
+    const ext3_t br[]{ one(), *this };
+    ext3_t res = one();
+
+    for (size_t i = 0; i < 64; i++) {
+      res = res.square();
+
+      const size_t bidx = 63 - i;
+      res = res * br[(n >> bidx) & 0b1ul];
+    }
+
+    return res;
+  }
+
+  // Check equality of two extension field elements
+  inline constexpr bool operator==(const ext3_t& rhs) const
+  {
+    return (c[0] == rhs.c[0]) & (c[1] == rhs.c[1]) & (c[2] == rhs.c[2]);
+  }
+
+  // Check inequality of two extension field elements
+  inline constexpr bool operator!=(const ext3_t& rhs) const
+  {
+    return !(*this == rhs);
+  }
+
+  // Generate a random extension field element
+  static inline ext3_t random()
+  {
+    return ext3_t{ ff_t::random(), ff_t::random(), ff_t::random() };
+  }
+};
+
+// Element of quadratic extension of Z_q
+using ff2_t = ext2_t<ff_t>;
+
+// Element of cubic extension of Z_q
+using ff3_t = ext3_t<ff_t>;
+
+// Extension field elements are laid out as their base field coefficients,
+// without any padding, so that an array of them can be read as an array of
+// Z_q elements, see `rescue_prime::hash`
+static_assert(sizeof(ff2_t) == 2 * sizeof(ff_t) &&
+              std::is_standard_layout_v<ff2_t>);
+static_assert(sizeof(ff3_t) == 3 * sizeof(ff_t) &&
+              std::is_standard_layout_v<ff3_t>);
+
+// Frobenius constants of cubic extension i.e. φ^q and φ^(2q), which are the
+// other two roots of φ^3 - φ - 1, computed during compilation
+constexpr ff3_t FROB1_PHI = ff3_t{ 0ul, 1ul } ^ Q;
+constexpr ff3_t FROB1_PHI2 = FROB1_PHI.square();
+
+// Frobenius constants of cubic extension i.e. φ^(q^2) and φ^(2q^2)
+constexpr ff3_t FROB2_PHI = FROB1_PHI ^ Q;
+constexpr ff3_t FROB2_PHI2 = FROB2_PHI.square();
+
+// Raises a cubic extension field element to q^k -th power | k ∈ {0, 1, 2},
+// which fixes base field coefficients, while mapping φ to φ^(q^k), so that
+// (a0 + a1φ + a2φ^2)^(q^k) = a0 + a1φ^(q^k) + a2φ^(2q^k)
+template<typename F>
+template<const size_t k>
+inline constexpr ext3_t<F>
+ext3_t<F>::frobenius() const
+{
+  static_assert(k < 3, "Frobenius map is identity for k = 3 !");
+
+  if constexpr (k == 0) {
+    return *this;
+  } else {
+    constexpr ff3_t phi = k == 1 ? FROB1_PHI : FROB2_PHI;
+    constexpr ff3_t phi2 = k == 1 ? FROB1_PHI2 : FROB2_PHI2;
+
+    return ext3_t{ c[0] } + phi * c[1] + phi2 * c[2];
+  }
+}
+
+// Writes an element of quadratic extension of Z_q to output stream
+inline std::ostream&
+operator<<(std::ostream& os, const ff2_t& elm)
+{
+  return os << "F_q2(" << elm.c[0].v << ", " << elm.c[1].v << ")";
+}
+
+// Writes an element of cubic extension of Z_q to output stream
+inline std::ostream&
+operator<<(std::ostream& os, const ff3_t& elm)
+{
+  return os << "F_q3(" << elm.c[0].v << ", " << elm.c[1].v << ", "
+            << elm.c[2].v << ")";
+}
+
+#if defined __AVX512F__ && USE_AVX2 != 0
+
+// Number of extension field elements processed together by batched kernels,
+// one in each lane of an AVX512 register
+constexpr size_t EXT_LANES = 8ul;
+
+// Coefficient type of extension field elements, processed by batched kernels
+using ext_lane_t = ff_avx512_t;
+
+#elif defined __AVX2__ && USE_AVX2 != 0
+
+// Number of extension field elements processed together by batched kernels,
+// one in each lane of an AVX2 register
+constexpr size_t EXT_LANES = 4ul;
+
+// Coefficient type of extension field elements, processed by batched kernels
+using ext_lane_t = ff_avx_t;
+
+#endif
+
+// Given two arrays of N ( >= 0 ) -many extension field elements ( of type E,
+// which is `ff2_t` or `ff3_t` ), this routine applies binary operation `op`
+// on each pair of elements, writing N -many results to output, which may alias
+// either of inputs.
+//
+// When SIMD backend is enabled, elements are processed `EXT_LANES` at a time,
+// where i-th coefficient of all of them is kept in a single register, so that
+// `op`, working on coefficients, is applied lane-parallel. Remaining elements
+// are processed one after another.
+template<typename E, typename Op>
+static inline void
+ext_apply_many(const E* const a, const E* const b, E* const c, const size_t n,
+               Op&& op)
+{
+  size_t i = 0;
+
+#if defined __AVX2__ && USE_AVX2 != 0
+  constexpr size_t D = E::DEGREE;
+  constexpr size_t L = EXT_LANES;
+  using V = typename E::template rebind_t<ext_lane_t>;
+
+  for (; i + L <= n; i += L) {
+    alignas(64) ff_t ta[D][L];
+    alignas(64) ff_t tb[D][L];
+
+    for (size_t j = 0; j < L; j++) {
+      for (size_t k = 0; k < D; k++) {
+        ta[k][j] = a[i + j].c[k];
+        tb[k][j] = b[i + j].c[k];
+      }
+    }
+
+    V va, vb;
+    for (size_t k = 0; k < D; k++) {
+      va.c[k] = ext_lane_t{ ta[k] };
+      vb.c[k] = ext_lane_t{ tb[k] };
+    }
+
+    const V vc = op(va, vb);
+    for (size_t k = 0; k < D; k++) {
+      vc.c[k].store(ta[k]);
+    }
+
+    for (size_t j = 0; j < L; j++) {
+      for (size_t k = 0; k < D; k++) {
+        c[i + j].c[k] = ta[k][j];
+      }
+    }
+  }
+#endif
+
+  for (; i < n; i++) {
+    c[i] = op(a[i], b[i]);
+  }
+}
+
+// Element wise addition of two arrays of N ( >= 0 ) -many extension field
+// elements, see `ext_apply_many`
+template<typename E>
+static inline void
+add_many(const E* const a, const E* const b, E* const c, const size_t n)
+{
+  ext_apply_many(a, b, c, n, [](const auto& x, const auto& y) {
+    return x + y;
+  });
+}
+
+// Element wise subtraction of two arrays of N ( >= 0 ) -many extension field
+// elements, see `ext_apply_many`
+template<typename E>
+static inline void
+sub_many(const E* const a, const E* const b, E* const c, const size_t n)
+{
+  ext_apply_many(a, b, c, n, [](const auto& x, const auto& y) {
+    return x - y;
+  });
+}
+
+// Element wise multiplication of two arrays of N ( >= 0 ) -many extension
+// field elements, see `ext_apply_many`
+template<typename E>
+static inline void
+mul_many(const E* const a, const E* const b, E* const c, const size_t n)
+{
+  ext_apply_many(a, b, c, n, [](const auto& x, const auto& y) {
+    return x * y;
+  });
+}
+
+// Element wise squaring of an array of N ( >= 0 ) -many extension field
+// elements, see `ext_apply_many`
+template<typename E>
+static inline void
+square_many(const E* const a, E* const c, const size_t n)
+{
+  ext_apply_many(a, a, c, n, [](const auto& x, const auto&) {
+    return x.square();
+  });
+}
+
+}
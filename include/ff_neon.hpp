@@ -82,6 +82,63 @@ full_mul_u64x2(const uint64x2_t lhs, const uint64x2_t rhs)
   return std::make_pair(res_hi, res_lo);
 }
 
+// Given a 128 -bit register, holding two 64 -bit unsigned integers, this
+// routine squares each of them, producing 128 -bit results, in same form as
+// `full_mul_u64x2` does, but cross term is computed only once and doubled, by
+// shifting, requiring three multiplications instead of four.
+static inline std::pair<uint64x2_t, uint64x2_t>
+full_sqr_u64x2(const uint64x2_t a)
+{
+  const auto a_hi = vmovn_u64(vshrq_n_u64(a, 32));
+  const auto a_lo = vmovn_u64(a);
+
+  const auto hh = vmull_u32(a_hi, a_hi);
+  const auto lh = vmull_u32(a_lo, a_hi);
+  const auto ll = vmull_u32(a_lo, a_lo);
+
+  // a^2 = hh * 2^64 + lh * 2^33 + ll
+  const auto t0 = vaddq_u64(lh, vshrq_n_u64(ll, 33));
+
+  const auto res_hi = vaddq_u64(hh, vshrq_n_u64(t0, 31));
+  const auto res_lo = vaddq_u64(ll, vshlq_n_u64(lh, 33));
+
+  return std::make_pair(res_hi, res_lo);
+}
+
+// Given two 128 -bit unsigned integers, as pair of 128 -bit registers, holding
+// high and low 64 -bits respectively ( see `full_mul_u64x2` ), this routine
+// reduces each of them modulo q, producing two elements ∈ Z_q.
+//
+// This routine does exactly what
+// https://github.com/itzmeanjan/rescue-prime/blob/22b7aa5/include/ff.hpp#L102-L125
+// does, after computing full multiplication, but it reduces two of them at a
+// time.
+static inline uint64x2_t
+reduce128(const uint64x2_t res_hi, const uint64x2_t res_lo)
+{
+  const auto u32x2 = vdupq_n_u64(static_cast<uint64_t>(UINT32_MAX));
+  const auto u64x2 = vdupq_n_u64(UINT64_MAX);
+
+  const auto c = vandq_u64(res_hi, u32x2);
+  const auto d = vshrq_n_u64(res_hi, 32);
+
+  const auto t2 = vsubq_u64(res_lo, d);
+  const auto t3 = vcltq_u64(res_lo, d);
+  const auto t4 = vshrq_n_u64(t3, 32);
+  const auto t5 = vsubq_u64(t2, t4);
+
+  const auto t6 = vshlq_n_u64(c, 32);
+  const auto t7 = vsubq_u64(t6, c);
+  const auto t8 = vaddq_u64(t5, t7);
+
+  const auto t9 = vsubq_u64(u64x2, t7);
+  const auto t10 = vcgtq_u64(t5, t9);
+  const auto t11 = vshrq_n_u64(t10, 32);
+  const auto t12 = vaddq_u64(t8, t11);
+
+  return reduce(t12);
+}
+
 // Two elements of prime field Z_q | q = 2^64 - 2^32 + 1, stored in a 128 -bit
 // Neon register, defining modular {addition, multiplication} over it.
 struct ff_neon_t
@@ -98,6 +155,13 @@ struct ff_neon_t
     v = vld1q_u64(reinterpret_cast<const uint64_t*>(arr));
   }
 
+  // Same as above, as Neon loads don't require aligned memory address; kept
+  // for symmetry with other vector types
+  static inline ff_neon_t load_unaligned(const ff::ff_t* const arr)
+  {
+    return ff_neon_t{ arr };
+  }
+
   // Given two 128 -bit registers, each holding two prime field Z_q elements,
   // this routine performs element wise addition over Z_q and returns result in
   // canonical form i.e. each 64 -bit result limb must ∈ Z_q.
@@ -131,32 +195,28 @@ struct ff_neon_t
   // time, it works on two of them.
   inline ff_neon_t operator*(const ff_neon_t& rhs) const
   {
-    const auto u32x2 = vdupq_n_u64(static_cast<uint64_t>(UINT32_MAX));
-    const auto u64x2 = vdupq_n_u64(UINT64_MAX);
-
-    const auto res = full_mul_u64x2(this->v, rhs.v);
-    const auto res_hi = res.first;
-    const auto res_lo = res.second;
-
-    const auto c = vandq_u64(res_hi, u32x2);
-    const auto d = vshrq_n_u64(res_hi, 32);
-
-    const auto t2 = vsubq_u64(res_lo, d);
-    const auto t3 = vcltq_u64(res_lo, d);
-    const auto t4 = vshrq_n_u64(t3, 32);
-    const auto t5 = vsubq_u64(t2, t4);
-
-    const auto t6 = vshlq_n_u64(c, 32);
-    const auto t7 = vsubq_u64(t6, c);
-    const auto t8 = vaddq_u64(t5, t7);
+    const auto [res_hi, res_lo] = full_mul_u64x2(this->v, rhs.v);
+    return ff_neon_t{ reduce128(res_hi, res_lo) };
+  }
 
-    const auto t9 = vsubq_u64(u64x2, t7);
-    const auto t10 = vcgtq_u64(t5, t9);
-    const auto t11 = vshrq_n_u64(t10, 32);
-    const auto t12 = vaddq_u64(t8, t11);
+  // Squares each of two prime field Z_q elements, which is cheaper than
+  // multiplying them by themselves, see `full_sqr_u64x2`.
+  inline ff_neon_t square() const
+  {
+    const auto [res_hi, res_lo] = full_sqr_u64x2(this->v);
+    return ff_neon_t{ reduce128(res_hi, res_lo) };
+  }
 
-    const auto t13 = reduce(t12);
-    return ff_neon_t{ t13 };
+  // Squares each element k ( >= 0 ) -many times in a row i.e. raises them to
+  // 2^k -th power, keeping intermediate result in register
+  template<const size_t k>
+  inline ff_neon_t square_n() const
+  {
+    auto res = *this;
+    for (size_t i = 0; i < k; i++) {
+      res = res.square();
+    }
+    return res;
   }
 
   // Stores two prime field Z_q elements ( kept in a 128 -bit register )
@@ -164,6 +224,9 @@ struct ff_neon_t
   {
     vst1q_u64(reinterpret_cast<uint64_t*>(arr), this->v);
   }
+
+  // Same as above, kept for symmetry with other vector types
+  inline void store_unaligned(ff::ff_t* const arr) const { store(arr); }
 };
 
 }
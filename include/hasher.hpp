@@ -0,0 +1,119 @@
+#pragma once
+#include "permutation_batch.hpp"
+#include "rescue_prime.hpp"
+
+// Rescue Prime Hashing over prime field Z_q, q = 2^64 - 2^32 + 1
+namespace rescue_prime {
+
+// Incremental Rescue Prime hasher, producing same digest as `hash`, when total
+// number of input elements is known before absorbing first of them, which is
+// required because `hash` keeps input length in capacity portion of the state.
+//
+// Hasher is trivially copyable, so that a copy of it, made after absorbing a
+// common prefix ( i.e. midstate ), can be resumed for many different suffixes,
+// without absorbing the prefix again, see `finalize_many`.
+struct hasher_t
+{
+  alignas(32) ff::ff_t state[rescue::STATE_WIDTH]{};
+
+  // Total number of elements to be absorbed
+  size_t ilen = 0;
+
+  // Number of elements absorbed so far
+  size_t absorbed = 0;
+
+  // Prepares hasher for absorbing exactly `ilen` -many elements
+  explicit hasher_t(const size_t ilen)
+    : ilen(ilen)
+  {
+    state[rescue::CAPACITY_BEGINS] = ff::ff_t{ ilen };
+  }
+
+  // Absorbs N ( >= 0 ) -many elements, permuting state whenever rate portion is
+  // full. Make sure that total number of absorbed elements doesn't exceed
+  // `ilen`.
+  void absorb(const ff::ff_t* const in, const size_t n)
+  {
+    instrument::bump(instrument::counter_t::absorbed, n);
+
+    for (size_t i = 0; i < n; i++) {
+      const size_t pos = absorbed & (rescue::RATE - 1);
+      ff::ff_t* const rate = state + rescue::RATE_BEGINS;
+
+      rate[pos] = rate[pos] + in[i];
+      absorbed++;
+
+      if (pos == rescue::RATE - 1) {
+        rescue::permute(state);
+      }
+    }
+  }
+
+  // Writes 4 -elements digest, permuting a copy of the state, when last block
+  // is only partially filled, so that hasher itself remains intact. Make sure
+  // that exactly `ilen` -many elements are absorbed.
+  void finalize(ff::ff_t* const out) const
+  {
+    alignas(32) ff::ff_t st[rescue::STATE_WIDTH];
+    std::memcpy(st, state, sizeof(st));
+
+    if ((absorbed & (rescue::RATE - 1)) != 0) {
+      rescue::permute(st);
+    }
+
+    std::memcpy(out, st + rescue::DIGEST_BEGINS, rescue::DIGEST_WIDTH << 3);
+  }
+};
+
+// Given a midstate ( i.e. hasher which has absorbed a common prefix ) and N
+// ( >= 0 ) -many suffixes, each of `slen` elements, laid out contiguously, this
+// routine computes digest of each prefix || suffix, writing 4N -many output
+// elements, same as resuming a copy of the midstate for each suffix.
+//
+// Copies of the midstate are resumed together, so that they are permuted a
+// batch at a time, see `rescue::permute_batch`. Make sure that midstate has
+// absorbed exactly (`mid.ilen` - `slen`) -many elements.
+static inline void
+finalize_many(const hasher_t& mid,
+              const ff::ff_t* const __restrict suffixes,
+              const size_t slen,
+              const size_t n,
+              ff::ff_t* const __restrict out)
+{
+  constexpr size_t W = rescue::STATE_WIDTH;
+  constexpr size_t B = rescue::BATCH_LANES;
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+
+  for (size_t i = 0; i < n; i += B) {
+    const size_t cnt = std::min(B, n - i);
+
+    alignas(32) ff::ff_t states[W * B];
+    for (size_t j = 0; j < cnt; j++) {
+      std::memcpy(states + j * W, mid.state, sizeof(mid.state));
+    }
+
+    size_t pos = mid.absorbed & (rescue::RATE - 1);
+    for (size_t k = 0; k < slen; k++) {
+      for (size_t j = 0; j < cnt; j++) {
+        ff::ff_t* const rate = states + j * W + rescue::RATE_BEGINS;
+        rate[pos] = rate[pos] + suffixes[(i + j) * slen + k];
+      }
+
+      if (++pos == rescue::RATE) {
+        rescue::permute_batch(states, cnt);
+        pos = 0;
+      }
+    }
+
+    if (pos != 0) {
+      rescue::permute_batch(states, cnt);
+    }
+
+    for (size_t j = 0; j < cnt; j++) {
+      const ff::ff_t* const st = states + j * W + rescue::DIGEST_BEGINS;
+      std::memcpy(out + (i + j) * D, st, D << 3);
+    }
+  }
+}
+
+}
@@ -0,0 +1,601 @@
+#pragma once
+#include "aligned.hpp"
+#include "hasher.hpp"
+#include "rescue_prime.hpp"
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined __linux__ && defined __NR_io_uring_setup
+#define INGEST_IO_URING 1
+#else
+#define INGEST_IO_URING 0
+#endif
+
+// Ingestion of Z_q elements from files/ pipes, overlapping reads with hashing
+namespace ingest {
+
+// Number of Z_q elements ( i.e. 256 KiB ) read at a time, by default
+constexpr size_t BLOCK_LEN = 1ul << 15;
+
+// How input is read asynchronously, where `automatic` picks io_uring, when
+// kernel supports it, otherwise falls back to a reader thread
+enum class backend_t
+{
+  automatic,
+  io_uring,
+  thread,
+};
+
+#if INGEST_IO_URING
+
+// Minimal io_uring instance, driven by raw system calls ( i.e. without
+// liburing ), which keeps a single read in flight, at current file position,
+// so that it works for both regular files and pipes.
+struct uring_t
+{
+  int fd = -1;
+  io_uring_params params{};
+
+  uint8_t* sq = nullptr;
+  size_t sq_len = 0;
+  uint8_t* cq = nullptr;
+  size_t cq_len = 0;
+  io_uring_sqe* sqes = nullptr;
+  size_t sqes_len = 0;
+
+  uring_t() = default;
+  uring_t(const uring_t&) = delete;
+  uring_t& operator=(const uring_t&) = delete;
+
+  ~uring_t()
+  {
+    if (sqes != nullptr) {
+      ::munmap(sqes, sqes_len);
+    }
+    if (cq != nullptr && cq != sq) {
+      ::munmap(cq, cq_len);
+    }
+    if (sq != nullptr) {
+      ::munmap(sq, sq_len);
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+  // Sets up submission and completion rings, returning false, if io_uring is
+  // not available ( say old kernel or blocked by seccomp ) or kernel can't
+  // read at current file position
+  bool setup()
+  {
+    fd = static_cast<int>(::syscall(__NR_io_uring_setup, 2u, &params));
+    if (fd < 0 || (params.features & IORING_FEAT_RW_CUR_POS) == 0) {
+      return false;
+    }
+
+    sq_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_len = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqes_len = params.sq_entries * sizeof(io_uring_sqe);
+
+    const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single) {
+      sq_len = cq_len = std::max(sq_len, cq_len);
+    }
+
+    sq = map(sq_len, IORING_OFF_SQ_RING);
+    cq = single ? sq : map(cq_len, IORING_OFF_CQ_RING);
+    sqes = reinterpret_cast<io_uring_sqe*>(map(sqes_len, IORING_OFF_SQES));
+
+    return sq != nullptr && cq != nullptr && sqes != nullptr;
+  }
+
+  // Submits read of upto `len` -bytes from given file descriptor, at its
+  // current position, into `buf`
+  bool submit_read(const int rfd, void* const buf, const unsigned len)
+  {
+    io_uring_sqe& sqe = next_sqe();
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = rfd;
+    sqe.addr = reinterpret_cast<uint64_t>(buf);
+    sqe.len = len;
+    sqe.off = static_cast<uint64_t>(-1);
+    sqe.user_data = READ_TAG;
+
+    return submit();
+  }
+
+  // Requests cancellation of submitted read ( say, one waiting on an idle pipe
+  // ), after which both read and cancel requests complete, in any order
+  bool submit_cancel()
+  {
+    io_uring_sqe& sqe = next_sqe();
+    sqe.opcode = IORING_OP_ASYNC_CANCEL;
+    sqe.fd = -1;
+    sqe.addr = READ_TAG;
+    sqe.user_data = CANCEL_TAG;
+
+    return submit();
+  }
+
+  // Waits for completion of a submitted request, returning its result i.e.
+  // number of bytes read ( 0 at end of input ) or negated error number, for
+  // read requests
+  long wait()
+  {
+    const auto& off = params.cq_off;
+    auto& head = *reinterpret_cast<unsigned*>(cq + off.head);
+    auto& tail = *reinterpret_cast<unsigned*>(cq + off.tail);
+    const auto mask = *reinterpret_cast<unsigned*>(cq + off.ring_mask);
+    auto* const cqes = reinterpret_cast<io_uring_cqe*>(cq + off.cqes);
+
+    while (true) {
+      const unsigned h = head;
+      const unsigned t =
+        std::atomic_ref<unsigned>{ tail }.load(std::memory_order_acquire);
+
+      if (h != t) {
+        const long res = cqes[h & mask].res;
+        std::atomic_ref<unsigned>{ head }.store(h + 1,
+                                                std::memory_order_release);
+        return res;
+      }
+
+      const auto ret = ::syscall(
+        __NR_io_uring_enter, fd, 0u, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (ret < 0 && errno != EINTR) {
+        return -errno;
+      }
+    }
+  }
+
+private:
+  // Tags identifying requests, in their completions
+  static constexpr uint64_t READ_TAG = 1ul;
+  static constexpr uint64_t CANCEL_TAG = 2ul;
+
+  // Returns zeroed entry of submission queue, at its tail
+  io_uring_sqe& next_sqe()
+  {
+    const auto& off = params.sq_off;
+    const auto tail = *reinterpret_cast<unsigned*>(sq + off.tail);
+    const auto mask = *reinterpret_cast<unsigned*>(sq + off.ring_mask);
+
+    io_uring_sqe& sqe = sqes[tail & mask];
+    std::memset(&sqe, 0, sizeof(sqe));
+    return sqe;
+  }
+
+  // Publishes entry at tail of submission queue and submits it to kernel
+  bool submit()
+  {
+    const auto& off = params.sq_off;
+    auto& tail = *reinterpret_cast<unsigned*>(sq + off.tail);
+    const auto mask = *reinterpret_cast<unsigned*>(sq + off.ring_mask);
+    auto* const array = reinterpret_cast<unsigned*>(sq + off.array);
+
+    const unsigned t = tail;
+    array[t & mask] = t & mask;
+    std::atomic_ref<unsigned>{ tail }.store(t + 1, std::memory_order_release);
+
+    while (true) {
+      const auto ret =
+        ::syscall(__NR_io_uring_enter, fd, 1u, 0u, 0u, nullptr, 0);
+      if (ret >= 0 || errno != EINTR) {
+        return ret == 1;
+      }
+    }
+  }
+
+  uint8_t* map(const size_t len, const off_t off) const
+  {
+    void* const ptr = ::mmap(nullptr,
+                             len,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE,
+                             fd,
+                             off);
+    return ptr == MAP_FAILED ? nullptr : static_cast<uint8_t*>(ptr);
+  }
+};
+
+#endif
+
+// Double-buffered reader of Z_q elements, kept as little-endian 64 -bit
+// unsigned integers ( i.e. raw `ff_t` values ), from a file descriptor of a
+// regular file or a pipe, which reads next block into one aligned buffer,
+// while caller processes previous block, kept in the other one.
+//
+// Values >= q are reduced, so that blocks hold canonical elements. Input length
+// must be a multiple of 8 -bytes, otherwise reader fails at end of input.
+//
+// Reader doesn't own the file descriptor. Destroying it before reaching end of
+// input cancels in-flight read, so that it doesn't block, when input is a pipe
+// whose writer is idle.
+struct reader_t
+{
+  int fd = -1;
+  size_t block = BLOCK_LEN;
+  backend_t mode = backend_t::thread;
+
+  ff::aligned_vector_t<ff::ff_t> bufs[2];
+
+  // Buffer to be handed out next, and whether other one was handed out
+  size_t cur = 0;
+  bool handed = false;
+
+  // Whether end of input is reached or read failed, so that no more blocks
+  // will be handed out
+  bool done = false;
+  bool good = true;
+
+#if INGEST_IO_URING
+  uring_t ring;
+  bool inflight = false;
+#endif
+
+  // State shared with reader thread, when io_uring is not used
+  std::thread thread;
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool full[2]{};
+  size_t filled[2]{};
+  bool failed[2]{};
+  bool stop = false;
+
+  // Self-pipe, whose read end is polled along with input, by reader thread, so
+  // that it can be woken up, while waiting for input, when reader is destroyed
+  int wake[2]{ -1, -1 };
+
+  // Starts reading from given file descriptor, in blocks of `block` -many Z_q
+  // elements, using requested backend, falling back to reader thread, when
+  // io_uring is requested but not available
+  explicit reader_t(const int fd,
+                    const backend_t backend = backend_t::automatic,
+                    const size_t block = BLOCK_LEN)
+    : fd(fd)
+    , block(std::max<size_t>(1, block))
+  {
+    for (auto& b : bufs) {
+      b.resize(this->block);
+    }
+
+#if INGEST_IO_URING
+    if (backend != backend_t::thread && ring.setup()) {
+      mode = backend_t::io_uring;
+      start_read(0);
+      return;
+    }
+#endif
+
+    mode = backend_t::thread;
+    if (::pipe(wake) != 0) {
+      wake[0] = wake[1] = -1;
+    }
+    thread = std::thread([this]() { run_thread(); });
+  }
+
+  reader_t(const reader_t&) = delete;
+  reader_t& operator=(const reader_t&) = delete;
+
+  ~reader_t()
+  {
+#if INGEST_IO_URING
+    if (inflight) {
+      // completions of both read and cancel requests are reaped, so that
+      // kernel is done with the buffer, before it's freed
+      const bool cancelled = ring.submit_cancel();
+      ring.wait();
+      if (cancelled) {
+        ring.wait();
+      }
+    }
+#endif
+
+    if (thread.joinable()) {
+      {
+        std::lock_guard lk{ mtx };
+        stop = true;
+      }
+      cv.notify_all();
+
+      if (wake[1] >= 0) {
+        const uint8_t b = 1;
+        [[maybe_unused]] const auto ret = ::write(wake[1], &b, 1);
+      }
+      thread.join();
+    }
+
+    for (const int f : wake) {
+      if (f >= 0) {
+        ::close(f);
+      }
+    }
+  }
+
+  // Backend actually used for reading
+  backend_t backend() const { return mode; }
+
+  // Whether all reads so far succeeded and input length is a multiple of 8
+  bool ok() const { return good; }
+
+  // Returns next block of ( upto `block` -many ) Z_q elements, which stays
+  // valid until next call, or empty span, at end of input or on failure ( see
+  // `ok` ). Handing out a block starts reading the one after it.
+  std::span<const ff::ff_t> next()
+  {
+    if (done) {
+      return {};
+    }
+
+    size_t bytes = 0;
+    bool err = false;
+
+#if INGEST_IO_URING
+    if (mode == backend_t::io_uring) {
+      err = !wait_read(cur, bytes);
+
+      // previous block is released, so next one can be read into its buffer
+      if (!err && bytes == block * sizeof(ff::ff_t)) {
+        start_read(cur ^ 1);
+      }
+    }
+#endif
+
+    if (mode == backend_t::thread) {
+      std::unique_lock lk{ mtx };
+      if (handed) {
+        full[cur ^ 1] = false;
+        cv.notify_all();
+      }
+
+      cv.wait(lk, [&]() { return full[cur]; });
+      bytes = filled[cur];
+      err = failed[cur];
+    }
+
+    const bool end = bytes < block * sizeof(ff::ff_t);
+    if (err || (end && (bytes % sizeof(ff::ff_t)) != 0)) {
+      good = false;
+      done = true;
+      return {};
+    }
+
+    done = end;
+    handed = true;
+
+    const size_t k = cur;
+    const size_t n = bytes / sizeof(ff::ff_t);
+    cur ^= 1;
+
+    for (size_t i = 0; i < n; i++) {
+      bufs[k][i] = ff::ff_t{ bufs[k][i].v };
+    }
+
+    return std::span<const ff::ff_t>{ bufs[k].data(), n };
+  }
+
+private:
+#if INGEST_IO_URING
+  // Submits read of a whole block into k-th buffer
+  void start_read(const size_t k)
+  {
+    const auto len = static_cast<unsigned>(block * sizeof(ff::ff_t));
+    inflight = ring.submit_read(fd, bufs[k].data(), len);
+    filled[k] = 0;
+    failed[k] = !inflight;
+  }
+
+  // Waits until k-th buffer is full or end of input is reached, resubmitting
+  // reads on short reads ( say from pipes ), returning false on failure
+  bool wait_read(const size_t k, size_t& bytes)
+  {
+    const size_t cap = block * sizeof(ff::ff_t);
+    auto* const dst = reinterpret_cast<uint8_t*>(bufs[k].data());
+
+    while (inflight) {
+      const long res = ring.wait();
+      inflight = false;
+
+      if (res < 0) {
+        return false;
+      }
+      filled[k] += static_cast<size_t>(res);
+
+      if (res > 0 && filled[k] < cap) {
+        const auto len = static_cast<unsigned>(cap - filled[k]);
+        inflight = ring.submit_read(fd, dst + filled[k], len);
+        if (!inflight) {
+          return false;
+        }
+      }
+    }
+
+    bytes = filled[k];
+    return !failed[k];
+  }
+#endif
+
+  // Waits until input is readable ( or at its end ), returning false, when
+  // reader is being destroyed, in the meantime
+  bool wait_input()
+  {
+    if (wake[0] < 0) {
+      return true;
+    }
+
+    pollfd fds[2]{ { fd, POLLIN, 0 }, { wake[0], POLLIN, 0 } };
+    while (::poll(fds, 2, -1) < 0) {
+      if (errno != EINTR) {
+        // let read report the failure
+        return true;
+      }
+    }
+
+    return fds[1].revents == 0;
+  }
+
+  // Fills buffers alternately, using blocking reads, until end of input or
+  // failure, waiting for caller to release a buffer, before reading into it
+  void run_thread()
+  {
+    const size_t cap = block * sizeof(ff::ff_t);
+
+    for (size_t k = 0;; k ^= 1) {
+      {
+        std::unique_lock lk{ mtx };
+        cv.wait(lk, [&]() { return stop || !full[k]; });
+        if (stop) {
+          return;
+        }
+      }
+
+      auto* const dst = reinterpret_cast<uint8_t*>(bufs[k].data());
+      size_t bytes = 0;
+      bool err = false;
+
+      while (bytes < cap) {
+        if (!wait_input()) {
+          return;
+        }
+
+        const auto ret = ::read(fd, dst + bytes, cap - bytes);
+        if (ret < 0 && errno == EINTR) {
+          continue;
+        }
+        if (ret <= 0) {
+          err = ret < 0;
+          break;
+        }
+        bytes += static_cast<size_t>(ret);
+      }
+
+      {
+        std::lock_guard lk{ mtx };
+        filled[k] = bytes;
+        failed[k] = err;
+        full[k] = true;
+      }
+      cv.notify_all();
+
+      if (err || bytes < cap) {
+        return;
+      }
+    }
+  }
+};
+
+// Given a reader of N ( > 0 ) -many Z_q elements, this routine computes Rescue
+// Prime digest, same as `rescue_prime::hash`, absorbing each block while next
+// one is being read. Returns false, when input doesn't hold exactly `ilen`
+// -many elements or it can't be read.
+static inline bool
+hash_stream(reader_t& rd, const size_t ilen, ff::ff_t* const out)
+{
+  rescue_prime::hasher_t hasher{ ilen };
+
+  for (auto blk = rd.next(); !blk.empty(); blk = rd.next()) {
+    if (blk.size() > ilen - hasher.absorbed) {
+      return false;
+    }
+    hasher.absorb(blk.data(), blk.size());
+  }
+
+  if (!rd.ok() || hasher.absorbed != ilen) {
+    return false;
+  }
+
+  hasher.finalize(out);
+  return true;
+}
+
+// Computes Rescue Prime digest of a file, holding raw Z_q elements, see
+// `hash_stream`. Returns false, when file can't be read or its length is not a
+// multiple of 8 -bytes.
+static inline bool
+hash_file(const std::string& path,
+          ff::ff_t* const out,
+          const backend_t backend = backend_t::automatic)
+{
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  bool res = ::fstat(fd, &st) == 0 && (st.st_size % sizeof(ff::ff_t)) == 0;
+
+  if (res) {
+    const size_t ilen = static_cast<size_t>(st.st_size) / sizeof(ff::ff_t);
+
+    reader_t rd{ fd, backend };
+    res = hash_stream(rd, ilen, out);
+  }
+
+  ::close(fd);
+  return res;
+}
+
+// Given a reader of Z_q elements, kept row-major, with `row_len` ( > 0 ) -many
+// elements per row, this routine computes Rescue Prime digest of each row,
+// same as `rescue_prime::hash`, appending them to `digests`, while next block
+// is being read. Rows lying within a block are hashed in place, while a row
+// spanning two blocks is absorbed incrementally, see `rescue_prime::hasher_t`.
+//
+// Returns false, when `row_len` is 0, input can't be read or its last row is
+// incomplete.
+static inline bool
+hash_rows_stream(reader_t& rd,
+                 const size_t row_len,
+                 std::vector<rescue_prime::digest_t>& digests)
+{
+  if (row_len == 0) {
+    return false;
+  }
+
+  rescue_prime::hasher_t partial{ row_len };
+
+  for (auto blk = rd.next(); !blk.empty(); blk = rd.next()) {
+    size_t i = 0;
+
+    if (partial.absorbed > 0) {
+      i = std::min(row_len - partial.absorbed, blk.size());
+      partial.absorb(blk.data(), i);
+
+      if (partial.absorbed == row_len) {
+        partial.finalize(digests.emplace_back().data());
+        partial = rescue_prime::hasher_t{ row_len };
+      }
+    }
+
+    for (; i + row_len <= blk.size(); i += row_len) {
+      auto& digest = digests.emplace_back();
+      rescue_prime::hash(blk.data() + i, row_len, digest.data());
+    }
+
+    if (i < blk.size()) {
+      partial.absorb(blk.data() + i, blk.size() - i);
+    }
+  }
+
+  return rd.ok() && partial.absorbed == 0;
+}
+
+}
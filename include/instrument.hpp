@@ -0,0 +1,154 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Opt-in instrumentation of hot paths i.e. Rescue permutation, its stages,
+// Rescue Prime hashing and Z_q arithmetic, counting calls, absorbed elements
+// and executed permutations, in thread-local counters.
+//
+// Instrumentation is enabled only when compiled with `-DUSE_INSTRUMENTATION=1`
+// ( see `INSTRUMENT` variable in Makefile ), otherwise each counter update is
+// an empty inline function, which is compiled away. Counters are never updated
+// during constant evaluation.
+namespace instrument {
+
+// Events being counted
+enum class counter_t : size_t
+{
+  permutations = 0, // # -of states permuted, including batched ones
+  permute_batch,    // # -of calls to `rescue::permute_batch`
+  hash,             // # -of calls to `rescue_prime::hash`
+  merge,            // # -of digest pairs merged
+  absorbed,         // # -of Z_q elements absorbed by hashing routines
+  sbox,             // # -of S-Box applications, on a state
+  inv_sbox,         // # -of inverse S-Box applications, on a state
+  mds,              // # -of MDS matrix multiplications, on a state
+  ff_mul,           // # -of Z_q multiplications, including ones by `ff_exp`
+  ff_inv,           // # -of Z_q inversions
+  ff_exp,           // # -of Z_q exponentiations, including ones by `ff_inv`
+};
+
+// Number of events being counted
+constexpr size_t COUNTER_CNT = static_cast<size_t>(counter_t::ff_exp) + 1;
+
+// Whether instrumentation is enabled or not, during compilation
+#if defined USE_INSTRUMENTATION && USE_INSTRUMENTATION != 0
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+// Values of all counters, at some point of time, or difference between two
+// such points
+struct snapshot_t
+{
+  std::array<uint64_t, COUNTER_CNT> counts{};
+
+  // Value of given counter
+  inline constexpr uint64_t operator[](const counter_t c) const
+  {
+    return counts[static_cast<size_t>(c)];
+  }
+
+  // Counter-wise sum of two snapshots ( say, of events counted on different
+  // threads )
+  inline constexpr snapshot_t operator+(const snapshot_t& rhs) const
+  {
+    snapshot_t res;
+    for (size_t i = 0; i < COUNTER_CNT; i++) {
+      res.counts[i] = counts[i] + rhs.counts[i];
+    }
+    return res;
+  }
+
+  // Counter-wise difference between two snapshots, where `rhs` must be taken
+  // before `this`
+  inline constexpr snapshot_t operator-(const snapshot_t& rhs) const
+  {
+    snapshot_t res;
+    for (size_t i = 0; i < COUNTER_CNT; i++) {
+      res.counts[i] = counts[i] - rhs.counts[i];
+    }
+    return res;
+  }
+};
+
+#if defined USE_INSTRUMENTATION && USE_INSTRUMENTATION != 0
+
+// Counters of calling thread
+inline thread_local snapshot_t counters{};
+
+#endif
+
+// Adds `n` to given counter of calling thread, if instrumentation is enabled
+// and it's not being constant evaluated, otherwise does nothing
+static inline constexpr void
+bump([[maybe_unused]] const counter_t c, [[maybe_unused]] const uint64_t n = 1)
+{
+#if defined USE_INSTRUMENTATION && USE_INSTRUMENTATION != 0
+  if (!std::is_constant_evaluated()) {
+    counters.counts[static_cast<size_t>(c)] += n;
+  }
+#endif
+}
+
+// Returns current value of all counters of calling thread, which are always
+// zero, if instrumentation is disabled
+static inline snapshot_t
+snapshot()
+{
+#if defined USE_INSTRUMENTATION && USE_INSTRUMENTATION != 0
+  return counters;
+#else
+  return snapshot_t{};
+#endif
+}
+
+// Resets all counters of calling thread to zero
+static inline void
+reset()
+{
+#if defined USE_INSTRUMENTATION && USE_INSTRUMENTATION != 0
+  counters = snapshot_t{};
+#endif
+}
+
+// Adds given counts ( say, of events executed on other threads, on behalf of
+// calling thread ) to counters of calling thread
+static inline void
+add([[maybe_unused]] const snapshot_t& d)
+{
+#if defined USE_INSTRUMENTATION && USE_INSTRUMENTATION != 0
+  counters = counters + d;
+#endif
+}
+
+// Sets counters of calling thread to given snapshot, taken earlier on same
+// thread, dropping events counted since then
+static inline void
+restore([[maybe_unused]] const snapshot_t& s)
+{
+#if defined USE_INSTRUMENTATION && USE_INSTRUMENTATION != 0
+  counters = s;
+#endif
+}
+
+// Takes snapshot of counters of calling thread when constructed, so that
+// events counted since then ( say, by a call site of interest ) can be read,
+// without resetting counters
+struct scope_t
+{
+  snapshot_t begin;
+
+  inline scope_t()
+    : begin(snapshot())
+  {
+  }
+
+  // Events counted since this scope began
+  inline snapshot_t delta() const { return snapshot() - begin; }
+};
+
+}
@@ -0,0 +1,382 @@
+#pragma once
+#include "aligned.hpp"
+#include "parallel.hpp"
+#include "rescue_prime.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Merkle tree like authenticated data structures, built on top of Rescue Prime
+// merge routine
+namespace merkle {
+
+using digest_t = rescue_prime::digest_t;
+
+// On-disk format of binary Merkle tree, built on top of Rescue Prime merge
+// routine, having N ( = 2^d ) -many leaves, where node i at height h + 1 is
+// merge(node 2i, node 2i + 1) at height h.
+//
+// File starts with 64 -bytes header, followed by all levels, bottom-up, each
+// kept contiguously as raw digests ( i.e. four Z_q elements, in native byte
+// order ), so that node i at height h lives at byte offset
+//
+//   64 + 32 * (2N - 2(N >> h) + i)
+//
+// and whole file is 64 + 32 * (2N - 1) -bytes.
+struct tree_file_header_t
+{
+  uint64_t magic;
+  uint32_t version;
+  uint32_t digest_width;
+  uint64_t leaf_count;
+  uint64_t depth;
+  uint64_t reserved[4];
+};
+
+static_assert(sizeof(tree_file_header_t) == 64, "Header must be 64 -bytes !");
+
+// "RPMERKLE", when read as little-endian 64 -bit unsigned integer
+constexpr uint64_t TREE_FILE_MAGIC = 0x454c4b52454d5052ul;
+constexpr uint32_t TREE_FILE_VERSION = 1u;
+
+// Number of digests, buffered per level by `tree_file_builder_t`, before being
+// written to file and merged into level above it
+constexpr size_t TREE_FILE_CHUNK = 1024ul;
+
+// Byte offset of node i at height h, in a tree file of N leaves
+static inline uint64_t
+tree_file_offset(const uint64_t leaf_count, const size_t h, const uint64_t i)
+{
+  const uint64_t before = 2 * leaf_count - 2 * (leaf_count >> h);
+  return sizeof(tree_file_header_t) + sizeof(digest_t) * (before + i);
+}
+
+// Streaming writer of Merkle tree file, which takes leaves in order, in
+// batches of any size, writing each level of the tree as its nodes are
+// computed, so that only a chunk of `TREE_FILE_CHUNK` digests is buffered per
+// level i.e. memory usage is O(d * chunk), no matter how many leaves are there.
+//
+// As number of leaves is known upfront, each level is written sequentially to
+// its own region of the file. Header is written last, by `finish`, after all
+// levels are flushed to storage, so that a partially written file is never
+// accepted by `tree_file_t`, even after a crash or power loss.
+struct tree_file_builder_t
+{
+  int fd = -1;
+  uint64_t leaf_count = 0;
+  size_t depth = 0;
+
+  // # -of leaves appended so far
+  uint64_t appended = 0;
+
+  // h-th entry holds digests at height h, not yet written to file, and number
+  // of digests of that level, written so far
+  std::vector<ff::aligned_vector_t<digest_t>> bufs;
+  std::vector<uint64_t> written;
+
+  // Threads used for merging a chunk into level above it
+  size_t nthreads = 1;
+  parallel::pool_t* pool = nullptr;
+
+  // Whether all writes so far succeeded
+  bool good = false;
+
+  // Creates ( or truncates ) file at given path, which will hold a Merkle tree
+  // of N -many leaves, where N must be a power of 2, otherwise program will
+  // panic ! Chunks are merged using `nthreads` -many threads of given pool (
+  // or default one, see `parallel::default_pool` ).
+  tree_file_builder_t(const std::string& path,
+                      const uint64_t n,
+                      const size_t nthreads = 1,
+                      parallel::pool_t* const pool = nullptr)
+    : leaf_count(n)
+    , depth(std::countr_zero(n))
+    , nthreads(nthreads)
+    , pool(pool)
+  {
+    assert(std::has_single_bit(n));
+
+    bufs.resize(depth + 1);
+    written.resize(depth + 1);
+    for (auto& b : bufs) {
+      b.reserve(TREE_FILE_CHUNK);
+    }
+
+    fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    good = fd >= 0;
+
+    if (good) {
+      const auto len = tree_file_offset(leaf_count, depth, 1);
+      good = ::ftruncate(fd, static_cast<off_t>(len)) == 0;
+    }
+  }
+
+  tree_file_builder_t(const tree_file_builder_t&) = delete;
+  tree_file_builder_t& operator=(const tree_file_builder_t&) = delete;
+
+  ~tree_file_builder_t()
+  {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+  // Whether file could be created and all writes so far succeeded
+  bool ok() const { return good; }
+
+  // Appends N ( >= 0 ) -many leaves, which, along with all leaves appended so
+  // far, must not exceed leaf count, otherwise program will panic !
+  void append(const digest_t* const leaves, const size_t n)
+  {
+    assert(n <= leaf_count - appended);
+
+    appended += n;
+    push(0, leaves, n);
+  }
+
+  // Writes remaining nodes of each level and the header, closing the file.
+  // Returns root of the tree, if all leaves were appended and all writes
+  // succeeded, in which case whole file is durable.
+  std::optional<digest_t> finish()
+  {
+    if (!good || appended != leaf_count) {
+      return std::nullopt;
+    }
+
+    // all levels, except top one, hold even number of digests, as chunk size
+    // and leaf count are powers of 2
+    for (size_t h = 0; h < depth; h++) {
+      flush(h);
+    }
+
+    const digest_t root = bufs[depth][0];
+    write(depth, bufs[depth].data(), 1);
+
+    // levels must be durable before header, which marks file as complete, so
+    // that it's not accepted after power loss, with levels partially written
+    good = good && ::fdatasync(fd) == 0;
+
+    tree_file_header_t hdr{};
+    hdr.magic = TREE_FILE_MAGIC;
+    hdr.version = TREE_FILE_VERSION;
+    hdr.digest_width = rescue::DIGEST_WIDTH;
+    hdr.leaf_count = leaf_count;
+    hdr.depth = depth;
+
+    const auto ret = ::pwrite(fd, &hdr, sizeof(hdr), 0);
+    good = good && ret == static_cast<ssize_t>(sizeof(hdr));
+    good = good && ::fdatasync(fd) == 0;
+    good = good && ::close(fd) == 0;
+    fd = -1;
+
+    return good ? std::optional<digest_t>{ root } : std::nullopt;
+  }
+
+private:
+  // Buffers digests at height h, flushing the buffer whenever it's full
+  void push(const size_t h, const digest_t* src, size_t n)
+  {
+    auto& buf = bufs[h];
+
+    while (n > 0) {
+      const size_t take = std::min(n, TREE_FILE_CHUNK - buf.size());
+      buf.insert(buf.end(), src, src + take);
+
+      src += take;
+      n -= take;
+
+      if (buf.size() == TREE_FILE_CHUNK && h < depth) {
+        flush(h);
+      }
+    }
+  }
+
+  // Writes buffered digests at height h, merging them pairwise into level
+  // above it
+  void flush(const size_t h)
+  {
+    auto& buf = bufs[h];
+    if (buf.empty()) {
+      return;
+    }
+
+    const size_t pairs = buf.size() >> 1;
+    write(h, buf.data(), buf.size());
+
+    digest_t parents[TREE_FILE_CHUNK / 2];
+    rescue_prime::merge_many(
+      buf[0].data(), pairs, parents[0].data(), nthreads, pool);
+
+    buf.clear();
+    push(h + 1, parents, pairs);
+  }
+
+  void write(const size_t h, const digest_t* const src, const size_t n)
+  {
+    const size_t len = n * sizeof(digest_t);
+    const auto off = tree_file_offset(leaf_count, h, written[h]);
+
+    const auto ret = ::pwrite(fd, src, len, static_cast<off_t>(off));
+    good = good && ret == static_cast<ssize_t>(len);
+    written[h] += n;
+  }
+};
+
+// Read-only view of Merkle tree file, written by `tree_file_builder_t`, which
+// is memory-mapped, so that nodes are read in place, without copying whole
+// tree into memory. Authentication path of a leaf touches a single page per
+// level ( i.e. at most d + 1 pages ), as kernel is advised against reading
+// ahead.
+struct tree_file_t
+{
+  const uint8_t* base = nullptr;
+  size_t len = 0;
+
+  uint64_t leaf_count = 0;
+  size_t depth = 0;
+
+  // Memory-maps Merkle tree file at given path, returning nothing, if it can't
+  // be opened or it's not a valid tree file of supported version
+  static std::optional<tree_file_t> open(const std::string& path)
+  {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return std::nullopt;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(tree_file_header_t)) {
+      ::close(fd);
+      return std::nullopt;
+    }
+
+    const size_t len = static_cast<size_t>(st.st_size);
+    void* const ptr = ::mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (ptr == MAP_FAILED) {
+      return std::nullopt;
+    }
+    ::madvise(ptr, len, MADV_RANDOM);
+
+    tree_file_t file;
+    file.base = static_cast<const uint8_t*>(ptr);
+    file.len = len;
+
+    tree_file_header_t hdr;
+    std::memcpy(&hdr, file.base, sizeof(hdr));
+
+    const bool valid =
+      (hdr.magic == TREE_FILE_MAGIC) && (hdr.version == TREE_FILE_VERSION) &&
+      (hdr.digest_width == rescue::DIGEST_WIDTH) && (hdr.depth < 63) &&
+      (hdr.leaf_count == (1ul << hdr.depth)) &&
+      (tree_file_offset(hdr.leaf_count, hdr.depth, 1) == len);
+    if (!valid) {
+      return std::nullopt;
+    }
+
+    file.leaf_count = hdr.leaf_count;
+    file.depth = hdr.depth;
+    return file;
+  }
+
+  tree_file_t() = default;
+  tree_file_t(const tree_file_t&) = delete;
+  tree_file_t& operator=(const tree_file_t&) = delete;
+
+  tree_file_t(tree_file_t&& other) noexcept
+    : base(std::exchange(other.base, nullptr))
+    , len(std::exchange(other.len, 0))
+    , leaf_count(other.leaf_count)
+    , depth(other.depth)
+  {
+  }
+
+  tree_file_t& operator=(tree_file_t&& other) noexcept
+  {
+    std::swap(base, other.base);
+    std::swap(len, other.len);
+    leaf_count = other.leaf_count;
+    depth = other.depth;
+    return *this;
+  }
+
+  ~tree_file_t()
+  {
+    if (base != nullptr) {
+      ::munmap(const_cast<uint8_t*>(base), len);
+    }
+  }
+
+  // Returns node i at height h, or nothing, when h > d or i >= N >> h
+  std::optional<digest_t> node(const size_t h, const uint64_t i) const
+  {
+    if (h > depth || i >= (leaf_count >> h)) {
+      return std::nullopt;
+    }
+
+    digest_t res;
+    std::memcpy(&res, base + tree_file_offset(leaf_count, h, i), sizeof(res));
+    return res;
+  }
+
+  std::optional<digest_t> leaf(const uint64_t i) const { return node(0, i); }
+  digest_t root() const { return *node(depth, 0); }
+
+  // Returns authentication path of the leaf at given index, holding sibling of
+  // each node on the path from the leaf up to ( but excluding ) the root, or
+  // nothing, when index is not less than leaf count
+  std::optional<std::vector<digest_t>> path(const uint64_t leaf_index) const
+  {
+    if (leaf_index >= leaf_count) {
+      return std::nullopt;
+    }
+
+    std::vector<digest_t> res;
+    res.reserve(depth);
+
+    uint64_t idx = leaf_index;
+    for (size_t h = 0; h < depth; h++) {
+      res.push_back(*node(h, idx ^ 1ul));
+      idx >>= 1;
+    }
+
+    return res;
+  }
+
+  // Verifies that the leaf is at given index of the tree with given root, by
+  // recomputing root using authentication path
+  static bool verify(const digest_t& root,
+                     const uint64_t leaf_index,
+                     const digest_t& leaf,
+                     const std::vector<digest_t>& path)
+  {
+    if (path.size() < 64 && (leaf_index >> path.size()) != 0) {
+      return false;
+    }
+
+    digest_t acc = leaf;
+    uint64_t idx = leaf_index;
+
+    for (const auto& sibling : path) {
+      acc = (idx & 1ul) ? rescue_prime::merge(sibling, acc)
+                        : rescue_prime::merge(acc, sibling);
+      idx >>= 1;
+    }
+
+    return acc == root;
+  }
+};
+
+}
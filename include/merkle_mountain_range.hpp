@@ -0,0 +1,232 @@
+#pragma once
+#include "rescue_prime.hpp"
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include <vector>
+
+// Merkle tree like authenticated data structures, built on top of Rescue Prime
+// merge routine
+namespace merkle {
+
+using digest_t = rescue_prime::digest_t;
+
+// Append-only Merkle Mountain Range accumulator, built on top of Rescue Prime
+// merge routine.
+//
+// Leaves are kept in perfect binary Merkle trees ( i.e. mountains ) of strictly
+// decreasing height, one for each set bit of the leaf count. Roots of those
+// mountains are called peaks, which are bagged into a single root.
+//
+// All nodes are kept in memory, level by level, so that inclusion proofs can be
+// generated. Node i at height h + 1 is merge(node 2i, node 2i + 1) at height h,
+// which means appending a leaf requires amortized single merge, while peak at
+// height h is always the last node at that height, when h-th bit of the leaf
+// count is set.
+struct mountain_range_t
+{
+  // Inclusion proof of a leaf, holding authentication path from the leaf up to
+  // the peak of the mountain it belongs to and all peaks of the accumulator
+  struct proof_t
+  {
+    uint64_t leaf_count = 0;
+    uint64_t leaf_index = 0;
+    std::vector<digest_t> path;
+    std::vector<digest_t> peaks;
+  };
+
+  // h-th entry holds all nodes at height h, where 0-th entry holds the leaves
+  std::vector<std::vector<digest_t>> levels;
+
+  // Returns number of leaves appended so far
+  uint64_t leaf_count() const { return levels.empty() ? 0 : levels[0].size(); }
+
+  // Appends a leaf, merging completed mountains of same height, which requires
+  // amortized single merge per append.
+  void append(const digest_t& leaf)
+  {
+    push(0, leaf);
+
+    size_t h = 0;
+    while ((levels[h].size() & 1ul) == 0) {
+      const auto& lvl = levels[h];
+      const auto parent = rescue_prime::merge(lvl[lvl.size() - 2], lvl.back());
+
+      push(++h, parent);
+    }
+  }
+
+  // Appends N ( >= 0 ) -many leaves at once, hashing whole new subtrees, level
+  // by level, using batched merge, which produces same accumulator, as if
+  // leaves were appended one by one.
+  //
+  // When `nthreads` > 1, each level is merged in parallel, on threads of given
+  // pool ( or default one, see `parallel::default_pool` ).
+  void append(const digest_t* const leaves,
+              const size_t n,
+              const size_t nthreads = 1,
+              parallel::pool_t* const pool = nullptr)
+  {
+    if (n == 0) {
+      return;
+    }
+
+    if (levels.empty()) {
+      levels.emplace_back();
+    }
+    levels[0].insert(levels[0].end(), leaves, leaves + n);
+
+    for (size_t h = 0; levels[h].size() > 1; h++) {
+      if (levels.size() == h + 1) {
+        levels.emplace_back();
+      }
+
+      auto& src = levels[h];
+      auto& dst = levels[h + 1];
+
+      const size_t beg = dst.size();
+      const size_t cnt = (src.size() >> 1) - beg;
+
+      // level above doesn't grow, so neither do ones above it
+      if (cnt == 0) {
+        break;
+      }
+
+      dst.resize(beg + cnt);
+      rescue_prime::merge_many(
+        src[beg << 1].data(), cnt, dst[beg].data(), nthreads, pool);
+    }
+  }
+
+  // Returns peaks of all mountains, ordered from the highest ( i.e. leftmost )
+  // one to the lowest ( i.e. rightmost ) one
+  std::vector<digest_t> peaks() const
+  {
+    const uint64_t n = leaf_count();
+
+    std::vector<digest_t> res;
+    for (size_t h = levels.size(); h > 0; h--) {
+      const size_t cnt = n >> (h - 1);
+
+      if (cnt & 1ul) {
+        res.push_back(levels[h - 1][cnt - 1]);
+      }
+    }
+
+    return res;
+  }
+
+  // Returns root of the accumulator, see `bag_peaks`
+  digest_t root() const { return bag_peaks(leaf_count(), peaks()); }
+
+  // Bags peaks into a single root, by folding them from the rightmost one to
+  // the leftmost one, using Rescue Prime merge, and then hashing the leaf count
+  // along with resulting digest, so that accumulators of different size never
+  // share same root.
+  static digest_t bag_peaks(const uint64_t leaf_count,
+                            const std::vector<digest_t>& peaks)
+  {
+    digest_t acc{};
+    if (!peaks.empty()) {
+      acc = peaks.back();
+
+      for (size_t i = peaks.size() - 1; i > 0; i--) {
+        acc = rescue_prime::merge(peaks[i - 1], acc);
+      }
+    }
+
+    ff::ff_t in[1 + rescue::DIGEST_WIDTH]{ ff::ff_t{ leaf_count } };
+    std::copy(acc.begin(), acc.end(), in + 1);
+
+    digest_t res;
+    rescue_prime::hash(in, 1 + rescue::DIGEST_WIDTH, res.data());
+    return res;
+  }
+
+  // Generates inclusion proof of the leaf at given index, which must be <
+  // leaf count.
+  proof_t prove(const uint64_t leaf_index) const
+  {
+    proof_t proof{ leaf_count(), leaf_index, {}, peaks() };
+
+    const size_t height = mountain_of(proof.leaf_count, leaf_index).second;
+
+    uint64_t idx = leaf_index;
+    for (size_t h = 0; h < height; h++) {
+      proof.path.push_back(levels[h][idx ^ 1ul]);
+      idx >>= 1;
+    }
+
+    return proof;
+  }
+
+  // Verifies that the proof attests that the leaf is included in the
+  // accumulator with given root, by recomputing peak of the mountain the leaf
+  // belongs to and then bagging all peaks.
+  static bool verify(const digest_t& root,
+                     const digest_t& leaf,
+                     const proof_t& proof)
+  {
+    if (proof.leaf_index >= proof.leaf_count) {
+      return false;
+    }
+
+    const auto [pidx, height] = mountain_of(proof.leaf_count, proof.leaf_index);
+
+    if ((proof.path.size() != height) ||
+        (proof.peaks.size() != static_cast<size_t>(std::popcount(
+                                 proof.leaf_count)))) {
+      return false;
+    }
+
+    digest_t acc = leaf;
+    uint64_t idx = proof.leaf_index;
+
+    for (size_t h = 0; h < height; h++) {
+      acc = (idx & 1ul) ? rescue_prime::merge(proof.path[h], acc)
+                        : rescue_prime::merge(acc, proof.path[h]);
+      idx >>= 1;
+    }
+
+    auto peaks = proof.peaks;
+    peaks[pidx] = acc;
+
+    return bag_peaks(proof.leaf_count, peaks) == root;
+  }
+
+private:
+  // Appends node at height h, allocating that level, if required
+  void push(const size_t h, const digest_t& node)
+  {
+    if (levels.size() == h) {
+      levels.emplace_back();
+    }
+    levels[h].push_back(node);
+  }
+
+  // Given leaf count and index of a leaf, returns index of the peak ( in order
+  // of `peaks()` ) of the mountain holding that leaf and height of the mountain
+  static std::pair<size_t, size_t> mountain_of(const uint64_t leaf_count,
+                                               const uint64_t leaf_index)
+  {
+    size_t pidx = 0;
+    uint64_t beg = 0;
+
+    for (size_t h = 64; h > 0; h--) {
+      const uint64_t width = 1ul << (h - 1);
+
+      if (leaf_count & width) {
+        if (leaf_index < beg + width) {
+          return { pidx, h - 1 };
+        }
+
+        beg += width;
+        pidx++;
+      }
+    }
+
+    return { pidx, 0 };
+  }
+};
+
+}
@@ -0,0 +1,231 @@
+#pragma once
+#include "aligned.hpp"
+#include "parallel.hpp"
+#include "rescue_prime.hpp"
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Merkle tree like authenticated data structures, built on top of Rescue Prime
+// merge routine
+namespace merkle {
+
+using digest_t = rescue_prime::digest_t;
+
+// Number of digests, buffered per level by `stream_builder_t`, before being
+// merged into level above it, which is also number of leaves produced at a
+// time, by `build_pipelined`
+constexpr size_t STREAM_CHUNK = 1024ul;
+
+// Streaming builder of binary Merkle tree, built on top of Rescue Prime merge
+// routine, which takes leaves in order, in batches of any size, without
+// knowing their count upfront, and computes root of the tree, keeping only a
+// chunk of `STREAM_CHUNK` digests per level i.e. memory usage is O(log(N) *
+// chunk), for N -many leaves.
+//
+// Node i at height h + 1 is merge(node 2i, node 2i + 1) at height h, while
+// last node of a level with odd number of nodes is promoted to the level above
+// it, so that, for N = 2^d, root is same as what `tree_file_builder_t`
+// computes. Chunks are merged as soon as they are full, so that completed
+// subtrees are hashed while leaves are still arriving.
+struct stream_builder_t
+{
+  // h-th entry holds digests at height h, which are not yet merged
+  std::vector<ff::aligned_vector_t<digest_t>> bufs;
+
+  // # -of leaves appended so far
+  uint64_t count = 0;
+
+  // Threads used for merging a chunk into level above it
+  size_t nthreads = 1;
+  parallel::pool_t* pool = nullptr;
+
+  // Creates a builder, which merges chunks using `nthreads` -many threads of
+  // given pool ( or default one, see `parallel::default_pool` )
+  explicit stream_builder_t(const size_t nthreads = 1,
+                            parallel::pool_t* const pool = nullptr)
+    : nthreads(nthreads)
+    , pool(pool)
+  {
+    // levels are never reallocated, as there can't be more than 64 of them
+    bufs.reserve(64);
+  }
+
+  // Appends N ( >= 0 ) -many leaves
+  void append(const digest_t* const leaves, const size_t n)
+  {
+    count += n;
+    push(0, leaves, n);
+  }
+
+  // Appends all leaves in [first, last)
+  template<typename It>
+  void append(It first, const It last)
+  {
+    digest_t batch[64];
+
+    while (first != last) {
+      size_t n = 0;
+      for (; n < std::size(batch) && first != last; n++, ++first) {
+        batch[n] = *first;
+      }
+      append(batch, n);
+    }
+  }
+
+  // Merges remaining nodes of each level, promoting last node of levels with
+  // odd number of nodes, and returns root of the tree. At least one leaf must
+  // have been appended, otherwise program will panic !
+  //
+  // Builder is reset, so that it can be reused for building another tree.
+  digest_t finish()
+  {
+    assert(count > 0);
+
+    digest_t root{};
+    for (size_t h = 0; h < bufs.size(); h++) {
+      auto& buf = bufs[h];
+
+      if (h + 1 == bufs.size() && buf.size() == 1) {
+        root = buf[0];
+        break;
+      }
+
+      const size_t pairs = buf.size() >> 1;
+      if (pairs > 0) {
+        merge(h, pairs);
+      }
+      if (buf.size() & 1ul) {
+        const digest_t last = buf.back();
+        push(h + 1, &last, 1);
+      }
+      buf.clear();
+    }
+
+    bufs.clear();
+    count = 0;
+    return root;
+  }
+
+private:
+  // Buffers digests at height h, merging the buffer whenever it's full
+  void push(const size_t h, const digest_t* src, size_t n)
+  {
+    if (bufs.size() == h) {
+      bufs.emplace_back();
+      bufs.back().reserve(STREAM_CHUNK);
+    }
+
+    while (n > 0) {
+      auto& buf = bufs[h];
+
+      const size_t take = std::min(n, STREAM_CHUNK - buf.size());
+      buf.insert(buf.end(), src, src + take);
+
+      src += take;
+      n -= take;
+
+      if (buf.size() == STREAM_CHUNK) {
+        merge(h, STREAM_CHUNK >> 1);
+        buf.clear();
+      }
+    }
+  }
+
+  // Merges first 2 * `pairs` digests at height h, pairwise, pushing resulting
+  // digests to level above it
+  void merge(const size_t h, const size_t pairs)
+  {
+    digest_t parents[STREAM_CHUNK / 2];
+    rescue_prime::merge_many(
+      bufs[h][0].data(), pairs, parents[0].data(), nthreads, pool);
+
+    push(h + 1, parents, pairs);
+  }
+};
+
+// Builds binary Merkle tree ( see `stream_builder_t` ) of leaves produced by
+// given callable, returning its root, where producing leaves is pipelined with
+// hashing them.
+//
+// Producer is invoked as `produce(digest_t* dst, size_t cap)`, on a thread of
+// its own, writing upto `cap` -many leaves to `dst` and returning how many it
+// wrote, while returning 0 signals end of leaves. Two buffers of `STREAM_CHUNK`
+// leaves are used, so that producer fills one of them, while calling thread
+// hashes the other one, merging chunks using `nthreads` -many threads of given
+// pool ( or default one, see `parallel::default_pool` ). At least one leaf must
+// be produced, otherwise program will panic !
+template<typename Producer>
+static inline digest_t
+build_pipelined(Producer&& produce,
+                const size_t nthreads = 1,
+                parallel::pool_t* const pool = nullptr)
+{
+  struct slot_t
+  {
+    std::vector<digest_t> leaves;
+    size_t len = 0;
+    bool full = false;
+  };
+
+  slot_t slots[2];
+  for (auto& s : slots) {
+    s.leaves.resize(STREAM_CHUNK);
+  }
+
+  std::mutex mtx;
+  std::condition_variable cv;
+
+  std::thread producer([&]() {
+    for (size_t k = 0;; k ^= 1) {
+      auto& slot = slots[k];
+      {
+        std::unique_lock lk{ mtx };
+        cv.wait(lk, [&]() { return !slot.full; });
+      }
+
+      const size_t len = produce(slot.leaves.data(), STREAM_CHUNK);
+      assert(len <= STREAM_CHUNK);
+      {
+        std::lock_guard lk{ mtx };
+        slot.len = len;
+        slot.full = true;
+      }
+      cv.notify_all();
+
+      if (len == 0) {
+        return;
+      }
+    }
+  });
+
+  stream_builder_t builder{ nthreads, pool };
+
+  for (size_t k = 0;; k ^= 1) {
+    auto& slot = slots[k];
+    {
+      std::unique_lock lk{ mtx };
+      cv.wait(lk, [&]() { return slot.full; });
+    }
+
+    if (slot.len == 0) {
+      break;
+    }
+    builder.append(slot.leaves.data(), slot.len);
+
+    {
+      std::lock_guard lk{ mtx };
+      slot.full = false;
+    }
+    cv.notify_all();
+  }
+
+  producer.join();
+  return builder.finish();
+}
+
+}
@@ -0,0 +1,436 @@
+#pragma once
+#include "instrument.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Helpers for running data-parallel loops of hashing routines on many threads
+namespace parallel {
+
+// Parses a sysfs list of ranges ( say "0-3,8-11" ), returning all integers in
+// them, where blank or malformed ranges are skipped, as cpulist of a NUMA node
+// having memory only ( say CXL or HBM ) is just a newline
+static inline std::vector<int>
+parse_ranges(const std::string& list)
+{
+  std::vector<int> res;
+
+  size_t pos = 0;
+  while (pos < list.size()) {
+    const size_t comma = std::min(list.find(',', pos), list.size());
+    std::string_view range{ list.data() + pos, comma - pos };
+    pos = comma + 1;
+
+    while (!range.empty() && std::isspace(static_cast<uint8_t>(range.back()))) {
+      range.remove_suffix(1);
+    }
+    while (!range.empty() && std::isspace(static_cast<uint8_t>(range[0]))) {
+      range.remove_prefix(1);
+    }
+
+    const char* const first = range.data();
+    const char* const last = range.data() + range.size();
+
+    int beg = 0;
+    auto [ptr, ec] = std::from_chars(first, last, beg);
+    if (ec != std::errc{}) {
+      continue;
+    }
+
+    int end = beg;
+    if (ptr != last) {
+      if (*ptr != '-') {
+        continue;
+      }
+      const auto r = std::from_chars(ptr + 1, last, end);
+      if (r.ec != std::errc{} || r.ptr != last) {
+        continue;
+      }
+    }
+
+    for (int v = beg; v <= end; v++) {
+      res.push_back(v);
+    }
+  }
+
+  return res;
+}
+
+// Returns whole content of a ( small ) file, or empty string, when it can't be
+// read
+static inline std::string
+read_file(const std::string& path)
+{
+  std::ifstream f{ path };
+  return std::string{ std::istreambuf_iterator<char>{ f }, {} };
+}
+
+// Returns CPUs of each NUMA node, which has any, read from sysfs, where nodes
+// are listed from `/sys/devices/system/node/online`, as node ids need not be
+// contiguous. When NUMA topology is not available, all CPUs are assumed to be
+// on a single node.
+static inline std::vector<std::vector<int>>
+numa_nodes()
+{
+  const std::string root = "/sys/devices/system/node/";
+
+  std::vector<std::vector<int>> nodes;
+
+  for (const int n : parse_ranges(read_file(root + "online"))) {
+    const auto path = root + "node" + std::to_string(n) + "/cpulist";
+
+    auto cpus = parse_ranges(read_file(path));
+    if (!cpus.empty()) {
+      nodes.push_back(std::move(cpus));
+    }
+  }
+
+  if (nodes.empty()) {
+    const int ncpus = std::max(1u, std::thread::hardware_concurrency());
+
+    nodes.emplace_back();
+    for (int c = 0; c < ncpus; c++) {
+      nodes[0].push_back(c);
+    }
+  }
+
+  return nodes;
+}
+
+// Persistent pool of worker threads, executing data-parallel jobs, so that
+// hashing routines ( say `rescue_prime::tree_hash` ) invoked concurrently, by
+// many callers, share a fixed number of threads, instead of each spawning its
+// own, which oversubscribes cores.
+//
+// Each worker owns a deque of tasks, popping from its back, while idle workers
+// steal from front of others' deques. Thread submitting a job executes its
+// tasks too, while waiting for it to finish, so that jobs can be submitted from
+// within tasks, without deadlocking the pool.
+//
+// When pinning is requested, workers are spread across NUMA nodes, round-robin,
+// and each is pinned to a CPU of its node ( on Linux ).
+struct pool_t
+{
+  // Job, whose tasks are indices ∈ [0, n), invoking type-erased function on
+  // each of them
+  struct job_t
+  {
+    void (*call)(void*, size_t);
+    void* ctx;
+
+    std::atomic<size_t> pending;
+    std::mutex mtx;
+    std::condition_variable done;
+
+    // Events counted while executing tasks of the job ( see `instrument` ),
+    // which are added to counters of submitting thread, once job is done
+    instrument::snapshot_t counts{};
+  };
+
+  // Single task of a job
+  struct task_t
+  {
+    job_t* job;
+    size_t idx;
+  };
+
+  struct worker_t
+  {
+    std::mutex mtx;
+    std::deque<task_t> tasks;
+    std::thread thread;
+  };
+
+  std::vector<std::unique_ptr<worker_t>> workers;
+
+  // # -of queued tasks, across all workers, while workers sleep when it's 0
+  std::atomic<size_t> queued{ 0 };
+  std::mutex mtx;
+  std::condition_variable wake;
+  bool stop = false;
+
+  // Worker to which next task, submitted by a non-worker thread, is pushed
+  std::atomic<size_t> next{ 0 };
+
+  // Creates a pool of `nworkers` -many threads, which, along with thread
+  // submitting a job, execute its tasks. Pool with no workers executes jobs on
+  // submitting thread.
+  explicit pool_t(const size_t nworkers, const bool pin = false)
+  {
+    workers.reserve(nworkers);
+    for (size_t i = 0; i < nworkers; i++) {
+      workers.push_back(std::make_unique<worker_t>());
+    }
+
+    const auto nodes = pin ? numa_nodes() : std::vector<std::vector<int>>{};
+
+    for (size_t i = 0; i < nworkers; i++) {
+      int cpu = -1;
+      if (pin) {
+        const auto& node = nodes[i % nodes.size()];
+        cpu = node[(i / nodes.size()) % node.size()];
+      }
+
+      auto fn = [this, i, cpu]() { run_worker(i, cpu); };
+      workers[i]->thread = std::thread(fn);
+    }
+  }
+
+  pool_t(const pool_t&) = delete;
+  pool_t& operator=(const pool_t&) = delete;
+
+  ~pool_t()
+  {
+    {
+      std::lock_guard lk{ mtx };
+      stop = true;
+    }
+    wake.notify_all();
+
+    for (auto& w : workers) {
+      w->thread.join();
+    }
+  }
+
+  // Number of threads, executing a job, including submitting one
+  size_t concurrency() const { return workers.size() + 1; }
+
+  // Invokes fn(i) for each i ∈ [0, n), on workers of the pool and calling
+  // thread, returning only after all of them are done. Calling thread executes
+  // fn(0) itself, while rest are pushed to deques of workers. Events counted by
+  // tasks ( see `instrument` ) are added to counters of calling thread.
+  template<typename Fn>
+  void run(const size_t n, Fn&& fn)
+  {
+    if (n == 0) {
+      return;
+    }
+    if (n == 1 || workers.empty()) {
+      for (size_t i = 0; i < n; i++) {
+        fn(i);
+      }
+      return;
+    }
+
+    using fn_t = std::remove_reference_t<Fn>;
+
+    job_t job{};
+    job.call = [](void* ctx, size_t i) { (*static_cast<fn_t*>(ctx))(i); };
+    job.ctx = const_cast<void*>(static_cast<const void*>(&fn));
+    job.pending.store(n);
+
+    // tasks submitted from within a worker go to its own deque, so that they
+    // are executed locally, unless other workers are idle
+    const size_t self = current_worker();
+    for (size_t i = 1; i < n; i++) {
+      const size_t w = self < workers.size()
+                         ? self
+                         : next.fetch_add(1) % workers.size();
+      push(w, task_t{ &job, i });
+    }
+
+    execute(task_t{ &job, 0 });
+
+    while (job.pending.load() > 0) {
+      task_t task;
+      if (try_pop(self, task)) {
+        execute(task);
+        continue;
+      }
+
+      // remaining tasks of the job are being executed by others, which will
+      // finish them, without needing help from this thread
+      std::unique_lock lk{ job.mtx };
+      job.done.wait(lk, [&]() { return job.pending.load() == 0; });
+    }
+
+    // last task may still be notifying, so job must outlive it
+    std::lock_guard lk{ job.mtx };
+    instrument::add(job.counts);
+  }
+
+private:
+  // Index of the worker of this pool, running on calling thread, or number of
+  // workers, when calling thread is not one of them
+  size_t current_worker() const
+  {
+    return owner() == this ? index() : workers.size();
+  }
+
+  static const pool_t*& owner()
+  {
+    thread_local const pool_t* pool = nullptr;
+    return pool;
+  }
+
+  static size_t& index()
+  {
+    thread_local size_t idx = 0;
+    return idx;
+  }
+
+  void push(const size_t w, const task_t task)
+  {
+    {
+      std::lock_guard lk{ mtx };
+      queued.fetch_add(1);
+    }
+    {
+      std::lock_guard lk{ workers[w]->mtx };
+      workers[w]->tasks.push_back(task);
+    }
+    wake.notify_one();
+  }
+
+  // Pops a task from back of own deque ( when calling thread is a worker ), or
+  // steals one from front of other workers' deques
+  bool try_pop(const size_t self, task_t& task)
+  {
+    if (self < workers.size()) {
+      auto& w = *workers[self];
+      std::lock_guard lk{ w.mtx };
+
+      if (!w.tasks.empty()) {
+        task = w.tasks.back();
+        w.tasks.pop_back();
+        queued.fetch_sub(1);
+        return true;
+      }
+    }
+
+    const size_t cnt = workers.size();
+    for (size_t k = 1; k <= cnt; k++) {
+      const size_t v = (self + k) % cnt;
+      if (v == self) {
+        continue;
+      }
+
+      auto& w = *workers[v];
+      std::lock_guard lk{ w.mtx };
+
+      if (!w.tasks.empty()) {
+        task = w.tasks.front();
+        w.tasks.pop_front();
+        queued.fetch_sub(1);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // Executes a task, moving events it counted ( see `instrument` ), from
+  // counters of executing thread to the job, so that they're attributed to
+  // thread which submitted it, no matter which thread executed the task
+  static void execute(const task_t task)
+  {
+    job_t& job = *task.job;
+
+    const auto before = instrument::snapshot();
+    job.call(job.ctx, task.idx);
+    const auto delta = instrument::snapshot() - before;
+    instrument::restore(before);
+
+    std::lock_guard lk{ job.mtx };
+    if constexpr (instrument::ENABLED) {
+      job.counts = job.counts + delta;
+    }
+    if (job.pending.fetch_sub(1) == 1) {
+      job.done.notify_all();
+    }
+  }
+
+  void run_worker(const size_t i, [[maybe_unused]] const int cpu)
+  {
+#if defined __linux__
+    if (cpu >= 0) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+      pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#endif
+
+    owner() = this;
+    index() = i;
+
+    while (true) {
+      task_t task;
+      if (try_pop(i, task)) {
+        execute(task);
+        continue;
+      }
+
+      std::unique_lock lk{ mtx };
+      wake.wait(lk, [&]() { return stop || queued.load() > 0; });
+      if (stop && queued.load() == 0) {
+        return;
+      }
+    }
+  }
+};
+
+// Returns pool shared by all parallel hashing routines, when caller doesn't
+// supply one, which is created on first use, with one worker less than number
+// of available hardware threads, as submitting thread also executes tasks
+static inline pool_t&
+default_pool()
+{
+  static pool_t pool{ std::max(1u, std::thread::hardware_concurrency()) - 1u };
+  return pool;
+}
+
+// Splits [0, n) into `nthreads` -many contiguous, nearly equal sized ranges,
+// invoking fn(beg, end) for each non-empty one of them, on workers of given
+// pool ( or default one, when none is supplied ), while calling thread takes
+// the first range.
+//
+// Partitioning only depends on `n` and `nthreads`, so callers writing to
+// disjoint output slots produce same result, no matter how many threads are
+// used.
+template<typename Fn>
+static inline void
+for_each_range(const size_t nthreads,
+               const size_t n,
+               Fn&& fn,
+               pool_t* const pool = nullptr)
+{
+  const size_t nt = std::max<size_t>(1, std::min(nthreads, n));
+  const size_t per = n / nt;
+  const size_t extra = n % nt;
+
+  if (n == 0) {
+    return;
+  }
+  if (nt == 1) {
+    fn(size_t{ 0 }, n);
+    return;
+  }
+
+  pool_t& p = pool != nullptr ? *pool : default_pool();
+  p.run(nt, [&](const size_t tidx) {
+    const size_t beg = tidx * per + std::min(tidx, extra);
+    const size_t end = beg + per + (tidx < extra);
+    fn(beg, end);
+  });
+}
+
+}
@@ -180,8 +180,8 @@ alignas(32) constexpr ff::ff_t RC1[ROUNDS * STATE_WIDTH]{
 static inline ff::ff_avx_t
 exp7(const ff::ff_avx_t v)
 {
-  const auto v2 = v * v;
-  const auto v4 = v2 * v2;
+  const auto v2 = v.square();
+  const auto v4 = v2.square();
   const auto v6 = v2 * v4;
   const auto v7 = v * v6;
 
@@ -199,8 +199,8 @@ exp7(const ff::ff_avx_t v)
 static inline ff::ff_neon_t
 exp7(const ff::ff_neon_t v)
 {
-  const auto v2 = v * v;
-  const auto v4 = v2 * v2;
+  const auto v2 = v.square();
+  const auto v4 = v2.square();
   const auto v6 = v2 * v4;
   const auto v7 = v * v6;
 
@@ -217,8 +217,8 @@ exp7(const ff::ff_neon_t v)
 static inline ff::ff_t
 exp7(const ff::ff_t v)
 {
-  const auto v2 = v * v;
-  const auto v4 = v2 * v2;
+  const auto v2 = v.square();
+  const auto v4 = v2.square();
   const auto v6 = v2 * v4;
   const auto v7 = v * v6;
 
@@ -232,6 +232,11 @@ exp7(const ff::ff_t v)
 // to perform cheaper exponentiation by a constant exponent, using lesser
 // multiplications.
 //
+// Elements of `base` are squared m -many times, before being multiplied by
+// `tail`, where squarings of all elements are interleaved, as they're
+// independent of each other, so that latency of one dependent chain is hidden
+// behind others. With AVX2, whole state is kept in registers meanwhile.
+//
 // Starting address of `base`, `tail` & `res` must be aligned to 32 -bytes
 // boundary, otherwise program will panic !
 template<const size_t m>
@@ -240,27 +245,27 @@ exp_acc(const ff::ff_t* const base,
         const ff::ff_t* const tail,
         ff::ff_t* const __restrict res)
 {
-  std::memcpy(res, base, sizeof(ff::ff_t) * STATE_WIDTH);
-
-  for (size_t i = 0; i < m; i++) {
-
 #if defined __AVX2__ && USE_AVX2 != 0
 
-#if defined __GNUC__
-#pragma GCC unroll 3
-#elif defined __clang__
-#pragma clang loop unroll(enable)
-#endif
-    for (size_t j = 0; j < 3; j++) {
-      const size_t off = j * 4;
+  ff::ff_avx_t t0{ base + 0 };
+  ff::ff_avx_t t1{ base + 4 };
+  ff::ff_avx_t t2{ base + 8 };
 
-      const ff::ff_avx_t t0{ res + off };
-      const auto t1 = t0 * t0;
-      t1.store(res + off);
-    }
+  for (size_t i = 0; i < m; i++) {
+    t0 = t0.square();
+    t1 = t1.square();
+    t2 = t2.square();
+  }
+
+  (t0 * ff::ff_avx_t{ tail + 0 }).store(res + 0);
+  (t1 * ff::ff_avx_t{ tail + 4 }).store(res + 4);
+  (t2 * ff::ff_avx_t{ tail + 8 }).store(res + 8);
 
 #else
 
+  std::memcpy(res, base, sizeof(ff::ff_t) * STATE_WIDTH);
+
+  for (size_t i = 0; i < m; i++) {
 #if defined __GNUC__
 #pragma GCC unroll 12
 #elif defined __clang__
@@ -269,30 +274,10 @@ exp_acc(const ff::ff_t* const base,
 #pragma clang loop interleave(enable)
 #endif
     for (size_t j = 0; j < STATE_WIDTH; j++) {
-      res[j] = res[j] * res[j];
+      res[j] = res[j].square();
     }
-
-#endif
   }
 
-#if defined __AVX2__ && USE_AVX2 != 0
-
-#if defined __GNUC__
-#pragma GCC unroll 3
-#elif defined __clang__
-#pragma clang loop unroll(enable)
-#endif
-  for (size_t i = 0; i < 3; i++) {
-    const size_t off = i * 4;
-
-    const ff::ff_avx_t t0{ res + off };
-    const ff::ff_avx_t t1{ tail + off };
-    const auto t2 = t0 * t1;
-    t2.store(res + off);
-  }
-
-#else
-
 #if defined __GNUC__
 #pragma GCC unroll 12
 #elif defined __clang__
@@ -315,6 +300,8 @@ exp_acc(const ff::ff_t* const base,
 static inline void
 apply_sbox(ff::ff_t* const state)
 {
+  instrument::bump(instrument::counter_t::sbox);
+
 #if defined __AVX2__ && USE_AVX2 != 0
 
 #if defined __GNUC__
@@ -373,6 +360,8 @@ apply_sbox(ff::ff_t* const state)
 static inline void
 apply_inv_sbox(ff::ff_t* const state)
 {
+  instrument::bump(instrument::counter_t::inv_sbox);
+
   alignas(32) ff::ff_t t1[STATE_WIDTH];
   alignas(32) ff::ff_t t2[STATE_WIDTH];
 
@@ -387,8 +376,8 @@ apply_inv_sbox(ff::ff_t* const state)
     const size_t off = i * 4;
 
     const ff::ff_avx_t s0{ state + off };
-    const auto s1 = s0 * s0;
-    const auto s2 = s1 * s1;
+    const auto s1 = s0.square();
+    const auto s2 = s1.square();
 
     s1.store(t1 + off);
     s2.store(t2 + off);
@@ -404,8 +393,8 @@ apply_inv_sbox(ff::ff_t* const state)
 #pragma clang loop interleave(enable)
 #endif
   for (size_t i = 0; i < STATE_WIDTH; i++) {
-    t1[i] = state[i] * state[i];
-    t2[i] = t1[i] * t1[i];
+    t1[i] = state[i].square();
+    t2[i] = t1[i].square();
   }
 
 #endif
@@ -436,11 +425,11 @@ apply_inv_sbox(ff::ff_t* const state)
     const size_t off = i * 4;
 
     const ff::ff_avx_t s0{ t7 + off };
-    const auto s1 = s0 * s0;
+    const auto s1 = s0.square();
     const ff::ff_avx_t s2{ t6 + off };
     const auto s3 = s1 * s2;
-    const auto s4 = s3 * s3;
-    const auto s5 = s4 * s4;
+    const auto s4 = s3.square();
+    const auto s5 = s4.square();
 
     const ff::ff_avx_t s6{ t1 + off };
     const ff::ff_avx_t s7{ t2 + off };
@@ -462,10 +451,10 @@ apply_inv_sbox(ff::ff_t* const state)
 #pragma clang loop interleave(enable)
 #endif
   for (size_t i = 0; i < STATE_WIDTH; i++) {
-    const auto a0 = t7[i] * t7[i];
+    const auto a0 = t7[i].square();
     const auto a1 = a0 * t6[i];
-    const auto a2 = a1 * a1;
-    const auto a3 = a2 * a2;
+    const auto a2 = a1.square();
+    const auto a3 = a2.square();
 
     const auto b0 = t1[i] * t2[i];
     const auto b1 = b0 * state[i];
@@ -632,6 +621,8 @@ accumulate_lanes(const ff::ff_avx_t vec)
 static inline void
 apply_mds(ff::ff_t* const state)
 {
+  instrument::bump(instrument::counter_t::mds);
+
   alignas(32) ff::ff_t tmp[STATE_WIDTH]{};
 
 #if defined __AVX2__ && USE_AVX2 != 0
@@ -767,6 +758,8 @@ apply_round(ff::ff_t* const state, const size_t ridx)
 static inline void
 permute(ff::ff_t* const state)
 {
+  instrument::bump(instrument::counter_t::permutations);
+
   for (size_t i = 0; i < ROUNDS; i++) {
     apply_round(state, i);
   }
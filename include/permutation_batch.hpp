@@ -0,0 +1,324 @@
+#pragma once
+#include "aligned.hpp"
+#include "permutation.hpp"
+#include <algorithm>
+#include <cassert>
+
+// Batched Rescue Permutation over prime field Z_q, q = 2^64 - 2^32 + 1
+//
+// `rescue::permute` works on a single state, which, when vectorized, needs
+// cross-lane shuffles for multiplying state by MDS matrix. Independent states
+// ( say chunks of a long message or nodes of a Merkle tree level ) can instead
+// be permuted lane-parallel, where i-th SIMD register holds i-th element of as
+// many states as there are lanes, so that every step of the permutation is a
+// lane-wise operation.
+namespace rescue {
+
+#if defined __AVX2__ && USE_AVX2 != 0
+
+// Number of states permuted together, one in each lane of an AVX2 register
+constexpr size_t BATCH_LANES = 4ul;
+
+// Lane-parallel vector type, holding same element of `BATCH_LANES` -many states
+using lane_t = ff::ff_avx_t;
+
+// Broadcasts an element ∈ Z_q to all lanes
+static inline lane_t
+splat(const ff::ff_t a)
+{
+  return lane_t{ _mm256_set1_epi64x(a.v) };
+}
+
+#else
+
+// Number of states permuted together, when no SIMD backend is enabled, whose
+// field operations are interleaved, so that multiplier pipeline is kept busy
+// with independent operations, instead of waiting on a single dependency chain
+constexpr size_t BATCH_LANES = 4ul;
+
+// Lane-parallel vector type, when no SIMD backend is enabled, holding same
+// element of `BATCH_LANES` -many states in an array, where each operation is
+// applied lane by lane, for all lanes, one after another.
+struct lane_t
+{
+  ff::ff_t v[BATCH_LANES];
+
+  inline lane_t() = default;
+
+  // Load `BATCH_LANES` -many elements ∈ Z_q from memory, where starting memory
+  // address need not be aligned
+  inline explicit lane_t(const ff::ff_t* const arr)
+  {
+    std::copy(arr, arr + BATCH_LANES, v);
+  }
+
+  // Lane-wise addition over Z_q
+  inline lane_t operator+(const lane_t& rhs) const
+  {
+    lane_t res;
+
+#if defined __GNUC__
+#pragma GCC unroll 4
+#endif
+    for (size_t i = 0; i < BATCH_LANES; i++) {
+      res.v[i] = v[i] + rhs.v[i];
+    }
+    return res;
+  }
+
+  // Lane-wise multiplication over Z_q
+  inline lane_t operator*(const lane_t& rhs) const
+  {
+    lane_t res;
+
+#if defined __GNUC__
+#pragma GCC unroll 4
+#endif
+    for (size_t i = 0; i < BATCH_LANES; i++) {
+      res.v[i] = v[i] * rhs.v[i];
+    }
+    return res;
+  }
+
+  // Lane-wise squaring over Z_q
+  inline lane_t square() const
+  {
+    lane_t res;
+
+#if defined __GNUC__
+#pragma GCC unroll 4
+#endif
+    for (size_t i = 0; i < BATCH_LANES; i++) {
+      res.v[i] = v[i].square();
+    }
+    return res;
+  }
+
+  // Same as above, as no alignment is required; kept for symmetry with SIMD
+  // lane types
+  static inline lane_t load_unaligned(const ff::ff_t* const arr)
+  {
+    return lane_t{ arr };
+  }
+
+  // Store `BATCH_LANES` -many elements ∈ Z_q to memory
+  inline void store(ff::ff_t* const arr) const
+  {
+    std::copy(v, v + BATCH_LANES, arr);
+  }
+
+  // Same as above, kept for symmetry with SIMD lane types
+  inline void store_unaligned(ff::ff_t* const arr) const { store(arr); }
+};
+
+// Broadcasts an element ∈ Z_q to all lanes
+static inline lane_t
+splat(const ff::ff_t a)
+{
+  lane_t res;
+  std::fill(res.v, res.v + BATCH_LANES, a);
+  return res;
+}
+
+#endif
+
+// Raises each lane to its 7-th power, see `exp7`
+static inline lane_t
+exp7_lanes(const lane_t v)
+{
+  const auto v2 = v.square();
+  const auto v4 = v2.square();
+  const auto v6 = v2 * v4;
+  const auto v7 = v * v6;
+
+  return v7;
+}
+
+// Lane-parallel counterpart of `exp_acc`, computing base^(2^m) * tail, for each
+// element of `BATCH_LANES` -many states.
+template<const size_t m>
+static inline void
+exp_acc_lanes(const lane_t* const base,
+              const lane_t* const tail,
+              lane_t* const __restrict res)
+{
+  std::copy(base, base + STATE_WIDTH, res);
+
+  for (size_t i = 0; i < m; i++) {
+#if defined __GNUC__
+#pragma GCC unroll 12
+#endif
+    for (size_t j = 0; j < STATE_WIDTH; j++) {
+      res[j] = res[j].square();
+    }
+  }
+
+#if defined __GNUC__
+#pragma GCC unroll 12
+#endif
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    res[i] = res[i] * tail[i];
+  }
+}
+
+// Lane-parallel counterpart of `apply_inv_sbox`, using same addition chain
+static inline void
+apply_inv_sbox_lanes(lane_t* const state)
+{
+  lane_t t1[STATE_WIDTH];
+  lane_t t2[STATE_WIDTH];
+
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    t1[i] = state[i].square();
+    t2[i] = t1[i].square();
+  }
+
+  lane_t t3[STATE_WIDTH];
+  exp_acc_lanes<3>(t2, t2, t3);
+
+  lane_t t4[STATE_WIDTH];
+  exp_acc_lanes<6>(t3, t3, t4);
+
+  lane_t t5[STATE_WIDTH];
+  exp_acc_lanes<12>(t4, t4, t5);
+
+  lane_t t6[STATE_WIDTH];
+  exp_acc_lanes<6>(t5, t3, t6);
+
+  lane_t t7[STATE_WIDTH];
+  exp_acc_lanes<31>(t6, t6, t7);
+
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    const auto a0 = t7[i].square();
+    const auto a1 = a0 * t6[i];
+    const auto a2 = a1.square();
+    const auto a3 = a2.square();
+
+    const auto b0 = t1[i] * t2[i];
+    const auto b1 = b0 * state[i];
+
+    state[i] = a3 * b1;
+  }
+}
+
+// Lane-parallel counterpart of `apply_mds`, where each MDS matrix entry is
+// broadcasted to all lanes, so that no cross-lane shuffle is required
+static inline void
+apply_mds_lanes(lane_t* const state)
+{
+  lane_t tmp[STATE_WIDTH];
+
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    const size_t off = i * STATE_WIDTH;
+
+    auto acc = state[0] * splat(MDS[off]);
+#if defined __GNUC__
+#pragma GCC unroll 11
+#endif
+    for (size_t j = 1; j < STATE_WIDTH; j++) {
+      acc = acc + state[j] * splat(MDS[off + j]);
+    }
+
+    tmp[i] = acc;
+  }
+
+  std::copy(tmp, tmp + STATE_WIDTH, state);
+}
+
+// Adds broadcasted round constants to lane-parallel Rescue permutation states
+static inline void
+add_rc_lanes(lane_t* const state, const ff::ff_t* const rc)
+{
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    state[i] = state[i] + splat(rc[i]);
+  }
+}
+
+// Rescue Permutation of 7 rounds, applied on `BATCH_LANES` -many states, kept
+// lane-parallel i.e. i-th lane of `state[j]` holds j-th element of i-th state.
+static inline void
+permute_lanes(lane_t* const state)
+{
+  instrument::bump(instrument::counter_t::permutations, BATCH_LANES);
+  instrument::bump(instrument::counter_t::sbox, ROUNDS * BATCH_LANES);
+  instrument::bump(instrument::counter_t::inv_sbox, ROUNDS * BATCH_LANES);
+  instrument::bump(instrument::counter_t::mds, 2 * ROUNDS * BATCH_LANES);
+
+  for (size_t r = 0; r < ROUNDS; r++) {
+    const size_t rc_off = r * STATE_WIDTH;
+
+    // first half
+    for (size_t i = 0; i < STATE_WIDTH; i++) {
+      state[i] = exp7_lanes(state[i]);
+    }
+    apply_mds_lanes(state);
+    add_rc_lanes(state, RC0 + rc_off);
+
+    // second half
+    apply_inv_sbox_lanes(state);
+    apply_mds_lanes(state);
+    add_rc_lanes(state, RC1 + rc_off);
+  }
+}
+
+// Given N ( >= 0 ) -many Rescue permutation states, laid out contiguously, this
+// routine permutes each of them, producing same result as invoking `permute`
+// on each state.
+//
+// States are permuted `BATCH_LANES` at a time, lane-parallel ( either in SIMD
+// lanes or interleaved, when no SIMD backend is enabled ), while remaining ones
+// are permuted using `permute`. Starting address of `states` must be aligned to
+// 32 -bytes boundary, otherwise program will panic !
+static inline void
+permute_batch(ff::ff_t* const states, const size_t n)
+{
+  instrument::bump(instrument::counter_t::permute_batch);
+
+  size_t i = 0;
+  constexpr size_t L = BATCH_LANES;
+
+  for (; i + L <= n; i += L) {
+    ff::ff_t* const st = states + i * STATE_WIDTH;
+
+    // transpose L states s.t. j-th row holds j-th element of all L states
+    alignas(32) ff::ff_t rows[STATE_WIDTH * L];
+    for (size_t j = 0; j < STATE_WIDTH; j++) {
+      for (size_t k = 0; k < L; k++) {
+        rows[j * L + k] = st[k * STATE_WIDTH + j];
+      }
+    }
+
+    lane_t lanes[STATE_WIDTH];
+    for (size_t j = 0; j < STATE_WIDTH; j++) {
+      lanes[j] = lane_t{ rows + j * L };
+    }
+
+    permute_lanes(lanes);
+
+    for (size_t j = 0; j < STATE_WIDTH; j++) {
+      lanes[j].store(rows + j * L);
+    }
+    for (size_t j = 0; j < STATE_WIDTH; j++) {
+      for (size_t k = 0; k < L; k++) {
+        st[k * STATE_WIDTH + j] = rows[j * L + k];
+      }
+    }
+  }
+
+  for (; i < n; i++) {
+    permute(states + i * STATE_WIDTH);
+  }
+}
+
+// Given a span of Rescue permutation states, laid out contiguously, whose
+// starting address is known to be aligned ( see `ff::aligned_span_t` ), this
+// routine permutes each of them, see `permute_batch` above. Length of the span
+// must be a multiple of `STATE_WIDTH`, otherwise program will panic !
+static inline void
+permute_batch(const ff::aligned_span_t<ff::ff_t, 32> states)
+{
+  assert(states.size() % STATE_WIDTH == 0);
+  permute_batch(states.data(), states.size() / STATE_WIDTH);
+}
+
+}
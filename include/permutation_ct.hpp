@@ -0,0 +1,226 @@
+#pragma once
+#include "permutation.hpp"
+#include <array>
+
+// Compile-time evaluable Rescue Permutation over prime field Z_q, q = 2^64 -
+// 2^32 + 1
+//
+// Runtime permutation ( see permutation.hpp ) works on raw, aligned memory and
+// dispatches to SIMD intrinsics, none of which can be evaluated in a constant
+// expression. Routines living here only depend on `constexpr` scalar
+// arithmetic, so that they can be used for generating tables ( say digests of
+// empty subtrees of a sparse Merkle tree or domain separation IVs ) at compile
+// time. Don't use these at runtime, they are much slower than `rescue::permute`.
+namespace rescue::ct {
+
+// Rescue permutation state, passed around by value, so that it can live inside
+// a constant expression
+using state_t = std::array<ff::ff_t, STATE_WIDTH>;
+
+// Rescue permutation state, holding canonical values of Z_q elements, on which
+// compile-time permutation actually operates.
+//
+// Constant expression evaluator executes each operation one by one, so keeping
+// raw 64 -bit words, instead of `ff::ff_t`, avoids lots of constructor and
+// member function invocations, making compile-time permutation ~10x quicker.
+using words_t = std::array<uint64_t, STATE_WIDTH>;
+
+// Addition over prime field Z_q, both input operands and result are canonical
+inline constexpr uint64_t
+add(const uint64_t a, const uint64_t b)
+{
+  const uint64_t t = a + b;
+  const bool flg = (t < a) | (t >= ff::Q);
+  return t - flg * ff::Q;
+}
+
+// Multiplication over prime field Z_q, both input operands and result are
+// canonical.
+//
+// When compiler supports 128 -bit integers, product is reduced using a single
+// modulo operation, which is a lot quicker to evaluate in a constant
+// expression, than going through all steps of Goldilocks reduction.
+inline constexpr uint64_t
+mul(const uint64_t a, const uint64_t b)
+{
+#if defined __SIZEOF_INT128__
+  __extension__ using uint128_t = unsigned __int128;
+
+  const auto c = static_cast<uint128_t>(a) * static_cast<uint128_t>(b);
+  return static_cast<uint64_t>(c % ff::Q);
+#else
+  return (ff::ff_t{ a } * ff::ff_t{ b }).v;
+#endif
+}
+
+// Raise an element ∈ Z_q to its 7-th power, by using less multiplications, than
+// one would do if done using standard exponentiation routine.
+//
+// Adapted from
+// https://github.com/novifinancial/winterfell/blob/437dc08/math/src/field/f64/mod.rs#L74-L82
+inline constexpr uint64_t
+exp7(const uint64_t v)
+{
+  const auto v2 = mul(v, v);
+  const auto v4 = mul(v2, v2);
+  const auto v6 = mul(v2, v4);
+  const auto v7 = mul(v, v6);
+
+  return v7;
+}
+
+// Compile-time evaluable counterpart of `rescue::exp_acc`, computing base^(2^m)
+// * tail, for each element of the state.
+template<const size_t m>
+inline constexpr words_t
+exp_acc(const words_t& base, const words_t& tail)
+{
+  words_t res = base;
+
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < STATE_WIDTH; j++) {
+      res[j] = mul(res[j], res[j]);
+    }
+  }
+
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    res[i] = mul(res[i], tail[i]);
+  }
+
+  return res;
+}
+
+// Applies substitution box on Rescue permutation state, by raising each element
+// to its 7-th power.
+inline constexpr void
+apply_sbox(words_t& state)
+{
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    state[i] = exp7(state[i]);
+  }
+}
+
+// Applies inverse substitution box on Rescue permutation state, by raising each
+// element to its 10540996611094048183-th power, using same addition chain as
+// `rescue::apply_inv_sbox`.
+inline constexpr void
+apply_inv_sbox(words_t& state)
+{
+  words_t t1{};
+  words_t t2{};
+
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    t1[i] = mul(state[i], state[i]);
+    t2[i] = mul(t1[i], t1[i]);
+  }
+
+  const auto t3 = exp_acc<3>(t2, t2);
+  const auto t4 = exp_acc<6>(t3, t3);
+  const auto t5 = exp_acc<12>(t4, t4);
+  const auto t6 = exp_acc<6>(t5, t3);
+  const auto t7 = exp_acc<31>(t6, t6);
+
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    const auto a0 = mul(t7[i], t7[i]);
+    const auto a1 = mul(a0, t6[i]);
+    const auto a2 = mul(a1, a1);
+    const auto a3 = mul(a2, a2);
+
+    const auto b0 = mul(t1[i], t2[i]);
+    const auto b1 = mul(b0, state[i]);
+
+    state[i] = mul(a3, b1);
+  }
+}
+
+// Adds round constants to Rescue permutation state, used during the first half
+// of Rescue permutation.
+inline constexpr void
+add_rc0(words_t& state, const size_t ridx)
+{
+  const size_t rc_off = ridx * STATE_WIDTH;
+
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    state[i] = add(state[i], RC0[rc_off + i].v);
+  }
+}
+
+// Adds round constants to Rescue permutation state, used during the last half
+// of Rescue permutation.
+inline constexpr void
+add_rc1(words_t& state, const size_t ridx)
+{
+  const size_t rc_off = ridx * STATE_WIDTH;
+
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    state[i] = add(state[i], RC1[rc_off + i].v);
+  }
+}
+
+// Multiplies Rescue permutation state by MDS matrix
+inline constexpr void
+apply_mds(words_t& state)
+{
+  words_t tmp{};
+
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    const size_t off = i * STATE_WIDTH;
+
+#if defined __SIZEOF_INT128__
+    __extension__ using uint128_t = unsigned __int128;
+
+    // MDS matrix entries are < 2^5, so sum of twelve products fits in 128 -bits
+    uint128_t acc = 0;
+    for (size_t j = 0; j < STATE_WIDTH; j++) {
+      acc += static_cast<uint128_t>(state[j]) * MDS[off + j].v;
+    }
+
+    tmp[i] = static_cast<uint64_t>(acc % ff::Q);
+#else
+    for (size_t j = 0; j < STATE_WIDTH; j++) {
+      tmp[i] = add(tmp[i], mul(state[j], MDS[off + j].v));
+    }
+#endif
+  }
+
+  state = tmp;
+}
+
+// Apply single Rescue permutation round
+inline constexpr void
+apply_round(words_t& state, const size_t ridx)
+{
+  // first half
+  apply_sbox(state);
+  apply_mds(state);
+  add_rc0(state, ridx);
+
+  // second half
+  apply_inv_sbox(state);
+  apply_mds(state);
+  add_rc1(state, ridx);
+}
+
+// Rescue Permutation of 7 rounds, producing exactly what `rescue::permute`
+// does, when invoked on same input state.
+inline constexpr state_t
+permute(const state_t& state)
+{
+  words_t words{};
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    words[i] = state[i].v;
+  }
+
+  for (size_t i = 0; i < ROUNDS; i++) {
+    apply_round(words, i);
+  }
+
+  state_t res{};
+  for (size_t i = 0; i < STATE_WIDTH; i++) {
+    res[i] = ff::ff_t{ words[i] };
+  }
+
+  return res;
+}
+
+}
@@ -0,0 +1,75 @@
+#ifndef RESCUE_PRIME_H
+#define RESCUE_PRIME_H
+
+/*
+ * C interface of `librescue_prime.so`, which exposes Rescue Prime hashing over
+ * prime field Z_q, q = 2^64 - 2^32 + 1, so that it can be called from other
+ * languages, over FFI.
+ *
+ * Library is compiled once for each supported backend ( say baseline x86-64,
+ * AVX2 and AVX512 ), one of which is picked at runtime, on first call, based on
+ * what running CPU supports. Setting environment variable `RP_BACKEND` to name
+ * of a backend ( see `rp_backend` ) forces it, when CPU supports it.
+ *
+ * Z_q elements are passed as 64 -bit unsigned integers, which must be canonical
+ * i.e. < q, otherwise digests are unspecified. Input and output buffers need
+ * not be aligned, but they must not overlap. Batch entry points take many
+ * independent inputs, so that a single call covers thousands of hashes.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Number of Z_q elements in a digest and in a Rescue permutation state */
+#define RP_DIGEST_WIDTH 4
+#define RP_STATE_WIDTH 12
+
+/* Name of backend used i.e. one of "generic", "avx2", "avx512" or "neon" */
+const char*
+rp_backend(void);
+
+/* Computes digest of `ilen` -many Z_q elements, writing 4 elements to `out` */
+void
+rp_hash(const uint64_t* in, size_t ilen, uint64_t* out);
+
+/* Merges two digests, given as 8 contiguous Z_q elements, into a single one */
+void
+rp_merge(const uint64_t* in, uint64_t* out);
+
+/*
+ * Computes digest of each of `n` -many messages, each of `ilen` -many Z_q
+ * elements, laid out contiguously, writing 4n -many elements to `out`, using
+ * `nthreads` -many threads ( 0 or 1 means calling thread only ).
+ */
+void
+rp_hash_many(const uint64_t* in,
+             size_t n,
+             size_t ilen,
+             uint64_t* out,
+             size_t nthreads);
+
+/*
+ * Merges each of `n` -many digest pairs, laid out contiguously as 8n -many Z_q
+ * elements, writing 4n -many elements to `out`, using `nthreads` -many threads
+ * ( 0 or 1 means calling thread only ).
+ */
+void
+rp_merge_many(const uint64_t* in, size_t n, uint64_t* out, size_t nthreads);
+
+/*
+ * Applies Rescue permutation on each of `n` -many states, each of 12 Z_q
+ * elements, laid out contiguously, in place.
+ */
+void
+rp_permute_batch(uint64_t* states, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,21 +1,39 @@
 #pragma once
+#include "ff_ext.hpp"
+#include "parallel.hpp"
 #include "permutation.hpp"
+#include "permutation_batch.hpp"
+#include <algorithm>
+#include <array>
 
 // Rescue Prime Hashing over prime field Z_q, q = 2^64 - 2^32 + 1
 namespace rescue_prime {
 
-// Given N ( > 0 ) -many Z_q elements as input, this routine computes Rescue
-// prime digest of four Z_q elements i.e. 32 -bytes wide.
+// Rescue Prime digest i.e. four Z_q elements, used as node of Merkle-like
+// structures built on top of `merge`
+using digest_t = std::array<ff::ff_t, rescue::DIGEST_WIDTH>;
+
+// Given N ( > 0 ) -many Z_q elements as input, this routine initializes Rescue
+// permutation state, keeping input length in its capacity portion, and absorbs
+// all of them, eight at a time, permuting state after each ( possibly partially
+// filled ) block, so that digest ( or output of `hash_xof` ) can be read from
+// the rate portion of the state.
+//
+// Input need not be aligned, as full blocks are read using unaligned SIMD loads
+// ( when a SIMD backend is enabled ), while starting address of `state` must be
+// aligned to 32 -bytes boundary, otherwise program will panic !
 //
 // This implementation is adapted from
 // https://github.com/novifinancial/winterfell/blob/21173bd/crypto/src/hash/rescue/rp64_256/mod.rs#L223-L256
 static inline void
-hash(const ff::ff_t* const __restrict in, // input elements ∈ Z_q
-     const size_t ilen,             // number of input elements to be hashed
-     ff::ff_t* const __restrict out // 4 output elements ∈ Z_q
+absorb(const ff::ff_t* const __restrict in, // input elements ∈ Z_q
+       const size_t ilen,               // number of input elements
+       ff::ff_t* const __restrict state // 12 state elements ∈ Z_q
 )
 {
-  alignas(32) ff::ff_t state[rescue::STATE_WIDTH]{};
+  instrument::bump(instrument::counter_t::absorbed, ilen);
+
+  std::fill_n(state, rescue::STATE_WIDTH, ff::ff_t::zero());
   state[rescue::CAPACITY_BEGINS] = ff::ff_t{ ilen };
 
   const size_t blk_cnt = ilen >> 3;
@@ -25,6 +43,42 @@ hash(const ff::ff_t* const __restrict in, // input elements ∈ Z_q
   for (size_t i = 0; i < blk_cnt; i++) {
     const size_t ioff = i << 3;
 
+#if defined __AVX2__ && USE_AVX2 != 0
+
+    // input block is read using unaligned loads, so that caller memory can be
+    // absorbed in place, while rate portion of the state is aligned
+#if defined __GNUC__
+#pragma GCC unroll 2
+#elif defined __clang__
+#pragma clang loop unroll(enable)
+#endif
+    for (size_t j = 0; j < rescue::RATE; j += 4) {
+      ff::ff_t* const st = state + rescue::RATE_BEGINS + j;
+
+      const ff::ff_avx_t s0{ st };
+      const auto s1 = ff::ff_avx_t::load_unaligned(in + ioff + j);
+      const auto s2 = s0 + s1;
+      s2.store(st);
+    }
+
+#elif defined __ARM_NEON && USE_NEON != 0
+
+#if defined __GNUC__
+#pragma GCC unroll 4
+#elif defined __clang__
+#pragma unroll 4
+#endif
+    for (size_t j = 0; j < rescue::RATE; j += 2) {
+      ff::ff_t* const st = state + rescue::RATE_BEGINS + j;
+
+      const ff::ff_neon_t s0{ st };
+      const auto s1 = ff::ff_neon_t::load_unaligned(in + ioff + j);
+      const auto s2 = s0 + s1;
+      s2.store(st);
+    }
+
+#else
+
 #if defined __GNUC__
 #pragma GCC unroll 8
 #elif defined __clang__
@@ -35,6 +89,8 @@ hash(const ff::ff_t* const __restrict in, // input elements ∈ Z_q
       state[soff + j] = state[soff + j] + in[ioff + j];
     }
 
+#endif
+
     rescue::permute(state);
   }
 
@@ -46,8 +102,226 @@ hash(const ff::ff_t* const __restrict in, // input elements ∈ Z_q
 
     rescue::permute(state);
   }
+}
+
+// Given N ( > 0 ) -many Z_q elements as input, this routine computes Rescue
+// prime digest of four Z_q elements i.e. 32 -bytes wide.
+static inline void
+hash(const ff::ff_t* const __restrict in, // input elements ∈ Z_q
+     const size_t ilen,             // number of input elements to be hashed
+     ff::ff_t* const __restrict out // 4 output elements ∈ Z_q
+)
+{
+  instrument::bump(instrument::counter_t::hash);
+
+  alignas(32) ff::ff_t state[rescue::STATE_WIDTH];
+  absorb(in, ilen, state);
+
+  std::memcpy(out, state + rescue::DIGEST_BEGINS, rescue::DIGEST_WIDTH << 3);
+}
+
+// Given N ( > 0 ) -many elements of quadratic extension of Z_q as input, this
+// routine computes Rescue Prime digest, absorbing each of them as its two base
+// field coefficients, in order, reading them in place, without copying, so
+// that digest is same as `hash` of 2N -many Z_q elements.
+static inline void
+hash(const ff::ff2_t* const __restrict in, // input elements ∈ F_q2
+     const size_t ilen,             // number of input elements to be hashed
+     ff::ff_t* const __restrict out // 4 output elements ∈ Z_q
+)
+{
+  const auto elms = reinterpret_cast<const ff::ff_t*>(in);
+  hash(elms, ilen * ff::ff2_t::DEGREE, out);
+}
+
+// Given N ( > 0 ) -many elements of cubic extension of Z_q as input, this
+// routine computes Rescue Prime digest, absorbing each of them as its three
+// base field coefficients, in order, reading them in place, without copying, so
+// that digest is same as `hash` of 3N -many Z_q elements.
+static inline void
+hash(const ff::ff3_t* const __restrict in, // input elements ∈ F_q3
+     const size_t ilen,             // number of input elements to be hashed
+     ff::ff_t* const __restrict out // 4 output elements ∈ Z_q
+)
+{
+  const auto elms = reinterpret_cast<const ff::ff_t*>(in);
+  hash(elms, ilen * ff::ff3_t::DEGREE, out);
+}
+
+// Given two Rescue Prime digests, this routine merges them into a single
+// digest, by absorbing both of them into the rate portion of the permutation
+// state, which is useful for building Merkle trees.
+//
+// Note, result is same as what `hash` produces when invoked on the eight
+// elements of the concatenated digests.
+//
+// This implementation is adapted from
+// https://github.com/novifinancial/winterfell/blob/21173bd/crypto/src/hash/rescue/rp64_256/mod.rs
+static inline void
+merge(const ff::ff_t* const __restrict lhs, // 4 input elements ∈ Z_q
+      const ff::ff_t* const __restrict rhs, // 4 input elements ∈ Z_q
+      ff::ff_t* const __restrict out        // 4 output elements ∈ Z_q
+)
+{
+  instrument::bump(instrument::counter_t::merge);
+  instrument::bump(instrument::counter_t::absorbed, rescue::RATE);
+
+  alignas(32) ff::ff_t state[rescue::STATE_WIDTH]{};
+  state[rescue::CAPACITY_BEGINS] = ff::ff_t{ rescue::RATE };
+
+  constexpr size_t soff0 = rescue::RATE_BEGINS;
+  constexpr size_t soff1 = soff0 + rescue::DIGEST_WIDTH;
+
+  std::memcpy(state + soff0, lhs, rescue::DIGEST_WIDTH << 3);
+  std::memcpy(state + soff1, rhs, rescue::DIGEST_WIDTH << 3);
+
+  rescue::permute(state);
 
   std::memcpy(out, state + rescue::DIGEST_BEGINS, rescue::DIGEST_WIDTH << 3);
 }
 
+// Merges two Rescue Prime digests into a single one, see above.
+static inline digest_t
+merge(const digest_t& lhs, const digest_t& rhs)
+{
+  digest_t out;
+  merge(lhs.data(), rhs.data(), out.data());
+  return out;
+}
+
+// Given N ( >= 0 ) -many pairs of Rescue Prime digests, laid out contiguously
+// as 8N -many Z_q elements, this routine merges each pair into a single digest,
+// writing 4N -many Z_q elements to output.
+//
+// Note, input layout is same as a level of a Merkle tree, where merging i-th
+// pair produces i-th node of the level above it. Pairs are merged a batch at a
+// time, see `rescue::permute_batch`.
+static inline void
+merge_many(const ff::ff_t* const __restrict in, // 8N input elements ∈ Z_q
+           const size_t n,                      // number of digest pairs
+           ff::ff_t* const __restrict out       // 4N output elements ∈ Z_q
+)
+{
+  constexpr size_t W = rescue::STATE_WIDTH;
+  constexpr size_t B = rescue::BATCH_LANES;
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+
+  instrument::bump(instrument::counter_t::merge, n);
+  instrument::bump(instrument::counter_t::absorbed, n * rescue::RATE);
+
+  for (size_t i = 0; i < n; i += B) {
+    const size_t cnt = std::min(B, n - i);
+
+    alignas(32) ff::ff_t states[W * B]{};
+    for (size_t j = 0; j < cnt; j++) {
+      ff::ff_t* const st = states + j * W;
+      const ff::ff_t* const pair = in + (i + j) * rescue::RATE;
+
+      st[rescue::CAPACITY_BEGINS] = ff::ff_t{ rescue::RATE };
+      std::memcpy(st + rescue::RATE_BEGINS, pair, rescue::RATE << 3);
+    }
+
+    rescue::permute_batch(states, cnt);
+
+    for (size_t j = 0; j < cnt; j++) {
+      const ff::ff_t* const st = states + j * W + rescue::DIGEST_BEGINS;
+      std::memcpy(out + (i + j) * D, st, D << 3);
+    }
+  }
+}
+
+// Given N ( >= 0 ) -many pairs of Rescue Prime digests, this routine merges
+// each pair into a single digest, same as `merge_many` above, splitting pairs
+// into `nthreads` -many contiguous ranges, which are merged on threads of given
+// pool ( or default one, see `parallel::default_pool` ).
+static inline void
+merge_many(const ff::ff_t* const __restrict in,   // 8N input elements ∈ Z_q
+           const size_t n,                        // number of digest pairs
+           ff::ff_t* const __restrict out,        // 4N output elements ∈ Z_q
+           const size_t nthreads,                 // number of threads to use
+           parallel::pool_t* const pool = nullptr // pool to run threads on
+)
+{
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+
+  auto pairs = [&](size_t beg, size_t end) {
+    merge_many(in + beg * rescue::RATE, end - beg, out + beg * D);
+  };
+  parallel::for_each_range(nthreads, n, pairs, pool);
+}
+
+// Given N ( >= 0 ) -many messages, each of M ( >= 0 ) -many Z_q elements, laid
+// out contiguously ( i.e. row-major ), this routine computes Rescue Prime
+// digest of each of them, writing 4N -many Z_q elements to output, same as
+// invoking `hash` on each message.
+//
+// Messages are hashed a batch at a time, where same block of each message of
+// the batch is absorbed, before permuting their states together, see
+// `rescue::permute_batch`. Input need not be aligned.
+static inline void
+hash_many(const ff::ff_t* const __restrict in, // NM input elements ∈ Z_q
+          const size_t n,                      // number of messages
+          const size_t ilen,                   // number of elements per message
+          ff::ff_t* const __restrict out       // 4N output elements ∈ Z_q
+)
+{
+  constexpr size_t W = rescue::STATE_WIDTH;
+  constexpr size_t B = rescue::BATCH_LANES;
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+  constexpr size_t R = rescue::RATE;
+
+  instrument::bump(instrument::counter_t::hash, n);
+  instrument::bump(instrument::counter_t::absorbed, n * ilen);
+
+  for (size_t i = 0; i < n; i += B) {
+    const size_t cnt = std::min(B, n - i);
+
+    alignas(32) ff::ff_t states[W * B]{};
+    for (size_t j = 0; j < cnt; j++) {
+      states[j * W + rescue::CAPACITY_BEGINS] = ff::ff_t{ ilen };
+    }
+
+    for (size_t off = 0; off < ilen; off += R) {
+      const size_t len = std::min(R, ilen - off);
+
+      for (size_t j = 0; j < cnt; j++) {
+        ff::ff_t* const st = states + j * W + rescue::RATE_BEGINS;
+        const ff::ff_t* const msg = in + (i + j) * ilen + off;
+
+        for (size_t k = 0; k < len; k++) {
+          st[k] = st[k] + msg[k];
+        }
+      }
+
+      rescue::permute_batch(states, cnt);
+    }
+
+    for (size_t j = 0; j < cnt; j++) {
+      const ff::ff_t* const st = states + j * W + rescue::DIGEST_BEGINS;
+      std::memcpy(out + (i + j) * D, st, D << 3);
+    }
+  }
+}
+
+// Given N ( >= 0 ) -many messages of equal length, this routine computes Rescue
+// Prime digest of each of them, same as `hash_many` above, splitting messages
+// into `nthreads` -many contiguous ranges, which are hashed on threads of given
+// pool ( or default one, see `parallel::default_pool` ).
+static inline void
+hash_many(const ff::ff_t* const __restrict in,   // NM input elements ∈ Z_q
+          const size_t n,                        // number of messages
+          const size_t ilen,                     // number of elements/ message
+          ff::ff_t* const __restrict out,        // 4N output elements ∈ Z_q
+          const size_t nthreads,                 // number of threads to use
+          parallel::pool_t* const pool = nullptr // pool to run threads on
+)
+{
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+
+  auto msgs = [&](size_t beg, size_t end) {
+    hash_many(in + beg * ilen, end - beg, ilen, out + beg * D);
+  };
+  parallel::for_each_range(nthreads, n, msgs, pool);
+}
+
 }
@@ -0,0 +1,140 @@
+#pragma once
+#include "permutation_ct.hpp"
+#include "rescue_prime.hpp"
+#include <algorithm>
+#include <utility>
+
+// Compile-time evaluable Rescue Prime Hashing over prime field Z_q, q = 2^64 -
+// 2^32 + 1, producing same digests as runtime routines living in
+// rescue_prime.hpp
+namespace rescue_prime::ct {
+
+// Given N ( >= 0 ) -many Z_q elements as input, this routine computes Rescue
+// prime digest of four Z_q elements, in a constant expression.
+//
+// See `rescue_prime::hash` for runtime counterpart.
+inline constexpr digest_t
+hash(const ff::ff_t* const in, const size_t ilen)
+{
+  rescue::ct::state_t state{};
+  state[rescue::CAPACITY_BEGINS] = ff::ff_t{ ilen };
+
+  size_t off = 0;
+  while (off < ilen) {
+    const size_t take = std::min(rescue::RATE, ilen - off);
+
+    for (size_t j = 0; j < take; j++) {
+      constexpr size_t soff = rescue::RATE_BEGINS;
+      state[soff + j] = state[soff + j] + in[off + j];
+    }
+
+    state = rescue::ct::permute(state);
+    off += take;
+  }
+
+  digest_t out{};
+  for (size_t i = 0; i < rescue::DIGEST_WIDTH; i++) {
+    out[i] = state[rescue::DIGEST_BEGINS + i];
+  }
+
+  return out;
+}
+
+// Compile-time evaluable Rescue Prime hash of a fixed length array of Z_q
+// elements.
+template<const size_t N>
+inline constexpr digest_t
+hash(const std::array<ff::ff_t, N>& in)
+{
+  return hash(in.data(), N);
+}
+
+// Merges two Rescue Prime digests into a single digest, in a constant
+// expression.
+//
+// See `rescue_prime::merge` for runtime counterpart.
+inline constexpr digest_t
+merge(const digest_t& lhs, const digest_t& rhs)
+{
+  rescue::ct::state_t state{};
+  state[rescue::CAPACITY_BEGINS] = ff::ff_t{ rescue::RATE };
+
+  for (size_t i = 0; i < rescue::DIGEST_WIDTH; i++) {
+    state[rescue::RATE_BEGINS + i] = lhs[i];
+    state[rescue::RATE_BEGINS + rescue::DIGEST_WIDTH + i] = rhs[i];
+  }
+
+  state = rescue::ct::permute(state);
+
+  digest_t out{};
+  for (size_t i = 0; i < rescue::DIGEST_WIDTH; i++) {
+    out[i] = state[rescue::DIGEST_BEGINS + i];
+  }
+
+  return out;
+}
+
+// Digest of an empty ( i.e. all leaves are zero digest ) binary Merkle subtree
+// of height h.
+//
+// Each height is a separate constant expression, so that compiler's constexpr
+// operation count limit applies to a single merge, instead of whole table.
+template<const size_t h>
+inline constexpr digest_t empty_subtree_digest =
+  merge(empty_subtree_digest<h - 1>, empty_subtree_digest<h - 1>);
+
+template<>
+inline constexpr digest_t empty_subtree_digest<0> = digest_t{};
+
+// Computes digests of empty binary Merkle subtrees of height 0, 1, ...,
+// `depth`, where i-th entry of returned array is the root of an empty subtree
+// of height i.
+//
+// Meant to be evaluated at compile time, as
+//
+// constexpr auto table = rescue_prime::ct::empty_subtree_digests<64>();
+//
+// so that sparse Merkle trees don't need to hash anything for default nodes.
+template<const size_t depth>
+inline constexpr std::array<digest_t, depth + 1>
+empty_subtree_digests()
+{
+  return []<size_t... h>(std::index_sequence<h...>)
+  {
+    return std::array<digest_t, depth + 1>{ empty_subtree_digest<h>... };
+  }
+  (std::make_index_sequence<depth + 1>{});
+}
+
+// Given an ASCII domain separation tag, this routine computes its Rescue Prime
+// digest, which can be used as initial value of domain separated hashes.
+//
+// Tag bytes are packed into field elements, seven bytes a time, in little
+// endian order, so that each packed element ∈ Z_q. Packed elements are
+// prepended with tag's byte length, so that no two tags collide.
+//
+// Meant to be evaluated at compile time, as
+//
+// constexpr auto iv = rescue_prime::ct::domain_iv("my-protocol/v1");
+template<const size_t N>
+inline constexpr digest_t
+domain_iv(const char (&tag)[N])
+{
+  constexpr size_t tlen = N - 1; // drop trailing null byte
+  constexpr size_t elen = 1 + (tlen + 6) / 7;
+
+  std::array<ff::ff_t, elen> elms{};
+  elms[0] = ff::ff_t{ tlen };
+
+  for (size_t i = 0; i < tlen; i++) {
+    const size_t eidx = 1 + i / 7;
+    const size_t boff = (i % 7) << 3;
+    const uint64_t byte = static_cast<uint8_t>(tag[i]);
+
+    elms[eidx] = ff::ff_t{ elms[eidx].v | (byte << boff) };
+  }
+
+  return hash(elms);
+}
+
+}
@@ -0,0 +1,318 @@
+#pragma once
+#include "parallel.hpp"
+#include "rescue_prime_ct.hpp"
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Merkle tree like authenticated data structures, built on top of Rescue Prime
+// merge routine
+namespace merkle {
+
+using digest_t = rescue_prime::digest_t;
+
+// Key-value pair, used for batch updating sparse Merkle tree
+using kv_t = std::pair<ff::ff_t, digest_t>;
+
+// Sparse Merkle tree of height `depth` ( default 64 ), keyed by elements ∈ Z_q,
+// where i-th leaf holds the digest associated with key i. Absent keys hold the
+// zero digest, so that an empty subtree of height h has the digest
+// `DEFAULTS[h]`, which is computed at compile time.
+//
+// Only non-default nodes are kept in memory, so memory consumption is
+// O(#-of non-empty leaves * depth). Interior node at height h + 1 and index i
+// is computed as merge(node(h, 2i), node(h, 2i + 1)).
+//
+// Note, a key k ∈ Z_q addresses the leaf at index (k mod 2^depth), so when
+// `depth` < 64, make sure that keys are < 2^depth.
+template<const size_t depth = 64>
+struct sparse_merkle_tree_t
+{
+  static_assert(depth > 0 && depth <= 64, "Depth must ∈ [1, 64] !");
+
+  // Digests of empty subtrees of height 0, 1, ..., depth
+  static constexpr auto DEFAULTS =
+    rescue_prime::ct::empty_subtree_digests<depth>();
+
+  // Authentication path of a leaf, which can be used for proving both
+  // membership ( i.e. `value` is non-zero ) and non-membership ( i.e. `value`
+  // is zero ) of a key.
+  //
+  // For keeping proofs short, siblings which are digests of empty subtrees are
+  // not stored, instead h-th bit of `defaults` is set when sibling at height h
+  // is `DEFAULTS[h]`. Non-default siblings are kept in order of increasing
+  // height.
+  struct proof_t
+  {
+    ff::ff_t key;
+    digest_t value;
+    uint64_t defaults = 0;
+    std::vector<digest_t> siblings;
+
+    // Whether this proof attests membership of the key
+    bool is_membership() const { return value != DEFAULTS[0]; }
+  };
+
+  // Non-default nodes, where h-th map holds nodes at height h, keyed by index
+  std::array<std::unordered_map<uint64_t, digest_t>, depth + 1> nodes;
+
+  // Returns digest of the node at height h and index idx
+  digest_t node(const size_t h, const uint64_t idx) const
+  {
+    const auto it = nodes[h].find(idx);
+    return it == nodes[h].end() ? DEFAULTS[h] : it->second;
+  }
+
+  // Returns root of the sparse Merkle tree
+  digest_t root() const { return node(depth, 0); }
+
+  // Returns digest associated with the key, which is the zero digest, if key is
+  // not present
+  digest_t get(const ff::ff_t key) const { return node(0, leaf_index(key)); }
+
+  // Associates digest with the key, recomputing all of its ancestors. Setting
+  // the zero digest removes the key.
+  void update(const ff::ff_t key, const digest_t& value)
+  {
+    const kv_t kv{ key, value };
+    update(&kv, 1);
+  }
+
+  // Associates digests with many keys at once, recomputing every ancestor,
+  // shared by a subset of updated leaves, exactly once. When a key appears more
+  // than once, last digest associated with it wins.
+  //
+  // When `nthreads` > 1, disjoint subtrees are recomputed in parallel, using
+  // those many threads of given pool ( or default one, see
+  // `parallel::default_pool` ), while resulting tree doesn't depend on
+  // `nthreads`.
+  void update(const kv_t* const kvs,
+              const size_t n,
+              const size_t nthreads = 1,
+              parallel::pool_t* const pool = nullptr)
+  {
+    if (n == 0) {
+      return;
+    }
+
+    level_t level = sorted_leaves(kvs, n);
+
+    // top `split` levels are recomputed by calling thread, while subtrees
+    // rooted at height (depth - split) are recomputed in parallel
+    size_t split = 0;
+    while ((split < depth) && ((1ul << split) < (nthreads << 2))) {
+      split++;
+    }
+    if (nthreads <= 1) {
+      split = depth;
+    }
+
+    const size_t bottom = depth - split;
+    if (bottom > 0) {
+      level = update_subtrees(std::move(level), bottom, nthreads, pool);
+    }
+
+    for (size_t h = bottom; h < depth; h++) {
+      store_level(h, level);
+      level = next_level(h, level);
+    }
+    store_level(depth, level);
+  }
+
+  // Generates authentication path of the leaf addressed by the key, which can
+  // be used for proving either membership or non-membership of the key.
+  proof_t prove(const ff::ff_t key) const
+  {
+    proof_t proof{ key, get(key), 0ul, {} };
+
+    uint64_t idx = leaf_index(key);
+    for (size_t h = 0; h < depth; h++) {
+      const auto sibling = node(h, idx ^ 1ul);
+
+      if (sibling == DEFAULTS[h]) {
+        proof.defaults |= 1ul << h;
+      } else {
+        proof.siblings.push_back(sibling);
+      }
+
+      idx >>= 1;
+    }
+
+    return proof;
+  }
+
+  // Verifies that the proof attests that `proof.key` is associated with
+  // `proof.value` ( which is zero digest for non-membership ) in the sparse
+  // Merkle tree with given root.
+  static bool verify(const digest_t& root, const proof_t& proof)
+  {
+    uint64_t idx = leaf_index(proof.key);
+    digest_t acc = proof.value;
+    size_t sidx = 0;
+
+    for (size_t h = 0; h < depth; h++) {
+      digest_t sibling;
+
+      if ((proof.defaults >> h) & 1ul) {
+        sibling = DEFAULTS[h];
+      } else {
+        if (sidx == proof.siblings.size()) {
+          return false;
+        }
+        sibling = proof.siblings[sidx++];
+      }
+
+      acc = (idx & 1ul) ? rescue_prime::merge(sibling, acc)
+                        : rescue_prime::merge(acc, sibling);
+      idx >>= 1;
+    }
+
+    return (sidx == proof.siblings.size()) && (acc == root);
+  }
+
+private:
+  // Updated nodes at some height, sorted by their index, with no duplicates
+  using level_t = std::vector<std::pair<uint64_t, digest_t>>;
+
+  // Returns index of the leaf addressed by the key
+  static constexpr uint64_t leaf_index(const ff::ff_t key)
+  {
+    if constexpr (depth == 64) {
+      return key.v;
+    } else {
+      return key.v & ((1ul << depth) - 1ul);
+    }
+  }
+
+  // Sorts updated leaves by their index, keeping only last digest associated
+  // with an index
+  static level_t sorted_leaves(const kv_t* const kvs, const size_t n)
+  {
+    level_t level;
+    level.reserve(n);
+
+    for (size_t i = 0; i < n; i++) {
+      level.emplace_back(leaf_index(kvs[i].first), kvs[i].second);
+    }
+
+    std::stable_sort(level.begin(), level.end(), [](auto& a, auto& b) {
+      return a.first < b.first;
+    });
+
+    size_t w = 0;
+    for (size_t r = 0; r < n; r++) {
+      if ((w > 0) && (level[w - 1].first == level[r].first)) {
+        level[w - 1] = level[r];
+      } else {
+        level[w++] = level[r];
+      }
+    }
+    level.resize(w);
+
+    return level;
+  }
+
+  // Given updated nodes at height h, this routine computes their updated
+  // parents, each of them exactly once, reading unchanged siblings from the
+  // tree, which is never written to.
+  level_t next_level(const size_t h, const level_t& level) const
+  {
+    level_t next;
+    next.reserve(level.size());
+
+    for (size_t i = 0; i < level.size(); i++) {
+      const uint64_t idx = level[i].first;
+
+      digest_t parent;
+      if (idx & 1ul) {
+        parent = rescue_prime::merge(node(h, idx ^ 1ul), level[i].second);
+      } else if ((i + 1 < level.size()) && (level[i + 1].first == idx + 1)) {
+        parent = rescue_prime::merge(level[i].second, level[i + 1].second);
+        i++;
+      } else {
+        parent = rescue_prime::merge(level[i].second, node(h, idx ^ 1ul));
+      }
+
+      next.emplace_back(idx >> 1, parent);
+    }
+
+    return next;
+  }
+
+  // Writes updated nodes at height h into the tree, dropping default ones
+  void store_level(const size_t h, const level_t& level)
+  {
+    for (const auto& [idx, digest] : level) {
+      if (digest == DEFAULTS[h]) {
+        nodes[h].erase(idx);
+      } else {
+        nodes[h].insert_or_assign(idx, digest);
+      }
+    }
+  }
+
+  // Recomputes disjoint subtrees, rooted at height `bottom`, in parallel, using
+  // `nthreads` -many threads of given pool. Each thread buffers updated nodes
+  // of subtrees it owns, which are written to the tree only after all threads
+  // are done, so that tree is only read concurrently.
+  //
+  // Returns updated roots of those subtrees, sorted by their index.
+  level_t update_subtrees(level_t leaves,
+                          const size_t bottom,
+                          const size_t nthreads,
+                          parallel::pool_t* const pool)
+  {
+    // partition leaves into contiguous groups, each belonging to same subtree
+    std::vector<std::pair<size_t, size_t>> groups;
+    for (size_t i = 0; i < leaves.size();) {
+      const uint64_t root = leaves[i].first >> bottom;
+
+      size_t j = i + 1;
+      while ((j < leaves.size()) && ((leaves[j].first >> bottom) == root)) {
+        j++;
+      }
+
+      groups.emplace_back(i, j);
+      i = j;
+    }
+
+    // h-th entry holds updated nodes at height h, of all subtrees
+    using updates_t = std::vector<level_t>;
+
+    std::vector<updates_t> updates(nthreads, updates_t(bottom));
+    level_t roots(groups.size());
+    std::atomic<size_t> next_group{ 0 };
+
+    auto worker = [&](const size_t tidx) {
+      size_t gidx;
+      while ((gidx = next_group.fetch_add(1)) < groups.size()) {
+        const auto [beg, end] = groups[gidx];
+        level_t level(leaves.begin() + beg, leaves.begin() + end);
+
+        for (size_t h = 0; h < bottom; h++) {
+          auto& dst = updates[tidx][h];
+          dst.insert(dst.end(), level.begin(), level.end());
+
+          level = next_level(h, level);
+        }
+
+        roots[gidx] = level[0];
+      }
+    };
+
+    parallel::pool_t& p = pool != nullptr ? *pool : parallel::default_pool();
+    p.run(nthreads, worker);
+
+    for (const auto& upd : updates) {
+      for (size_t h = 0; h < bottom; h++) {
+        store_level(h, upd[h]);
+      }
+    }
+
+    return roots;
+  }
+};
+
+}
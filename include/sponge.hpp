@@ -0,0 +1,136 @@
+#pragma once
+#include "permutation.hpp"
+#include <span>
+
+// Rescue Prime Hashing over prime field Z_q, q = 2^64 - 2^32 + 1
+namespace rescue_prime {
+
+// Stateful duplex sponge over Rescue permutation, which can alternate between
+// absorbing and squeezing any number of times, as needed by interactive
+// protocols ( say Fiat-Shamir transcripts ), where prover messages are absorbed
+// and challenges are squeezed, without hashing whole transcript again.
+//
+// Elements are absorbed into/ squeezed from rate portion of the state ( see
+// `rescue::RATE_BEGINS` ), while capacity portion is never exposed. State is
+// permuted lazily, only when rate portion is exhausted and more elements need
+// to be absorbed/ squeezed, or when switching from absorbing to squeezing, so
+// that no permutation is wasted.
+//
+// When first capacity element is initialized to N and exactly N -many elements
+// are absorbed, squeezed elements are same as output of `hash_xof` ( hence
+// first four of them are same as digest computed by `hash` ).
+//
+// Sponge is trivially copyable, so that it can be forked at any point, see
+// `clone`.
+struct sponge_t
+{
+  // Whether elements are being absorbed or squeezed
+  enum class mode_t
+  {
+    absorbing,
+    squeezing,
+  };
+
+  alignas(32) ff::ff_t state[rescue::STATE_WIDTH]{};
+
+  // Position in rate portion, where next element is absorbed/ squeezed
+  size_t pos = 0;
+
+  mode_t mode = mode_t::absorbing;
+
+  // Creates a sponge with all-zero state
+  sponge_t() = default;
+
+  // Creates a sponge, whose first capacity element is set to given domain
+  // separator, so that sponges used for different purposes don't collide
+  explicit sponge_t(const ff::ff_t domain)
+  {
+    state[rescue::CAPACITY_BEGINS] = domain;
+  }
+
+  // Absorbs N ( >= 0 ) -many elements, adding them to rate portion of the
+  // state, starting at current position, permuting state whenever rate portion
+  // is full and more elements are left to be absorbed.
+  //
+  // If sponge was squeezing, absorption starts at beginning of rate portion,
+  // without permuting state.
+  void absorb(const std::span<const ff::ff_t> in)
+  {
+    instrument::bump(instrument::counter_t::absorbed, in.size());
+
+    if (mode == mode_t::squeezing) {
+      mode = mode_t::absorbing;
+      pos = 0;
+    }
+
+    ff::ff_t* const rate = state + rescue::RATE_BEGINS;
+
+    for (const auto v : in) {
+      if (pos == rescue::RATE) {
+        rescue::permute(state);
+        pos = 0;
+      }
+
+      rate[pos] = rate[pos] + v;
+      pos++;
+    }
+  }
+
+  // Squeezes N ( >= 0 ) -many elements, reading them from rate portion of the
+  // state, starting at current position, permuting state whenever all rate
+  // elements are read and more elements are left to be squeezed.
+  //
+  // If sponge was absorbing, state is permuted first and squeezing starts at
+  // beginning of rate portion.
+  void squeeze(const std::span<ff::ff_t> out)
+  {
+    if (out.empty()) {
+      return;
+    }
+
+    if (mode == mode_t::absorbing) {
+      rescue::permute(state);
+      mode = mode_t::squeezing;
+      pos = 0;
+    }
+
+    const ff::ff_t* const rate = state + rescue::RATE_BEGINS;
+
+    for (auto& v : out) {
+      if (pos == rescue::RATE) {
+        rescue::permute(state);
+        pos = 0;
+      }
+
+      v = rate[pos];
+      pos++;
+    }
+  }
+
+  // Squeezes single element, see `squeeze` above
+  ff::ff_t squeeze()
+  {
+    ff::ff_t v;
+    squeeze(std::span<ff::ff_t>{ &v, 1 });
+    return v;
+  }
+
+  // Permutes state right away, resetting position to beginning of rate
+  // portion, without changing mode, so that next absorbed/ squeezed element
+  // belongs to a fresh block, say for separating protocol rounds.
+  void permute_now()
+  {
+    rescue::permute(state);
+    pos = 0;
+  }
+
+  // Position in rate portion ∈ [0, RATE], where next element is absorbed/
+  // squeezed, which is RATE, when rate portion is exhausted
+  size_t position() const { return pos; }
+
+  // Returns an independent copy of the sponge, which can be used to continue
+  // from current point, without affecting this one
+  sponge_t clone() const { return *this; }
+};
+
+}
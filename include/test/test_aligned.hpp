@@ -0,0 +1,151 @@
+#pragma once
+#include "aligned.hpp"
+#include "permutation_batch.hpp"
+#include "rescue_prime.hpp"
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Check that aligned allocator and arena hand out buffers aligned to requested
+// boundary, that arena refuses requests it can't serve and can be reused after
+// reset
+inline void
+test_aligned_buffers()
+{
+  for (size_t n = 1; n <= 33; n++) {
+    ff::aligned_vector_t<ff::ff_t> v(n);
+    assert(ff::is_aligned<ff::ALIGNMENT>(v.data()));
+
+    ff::aligned_vector_t<ff::ff_t, 128> w(n);
+    assert(ff::is_aligned<128>(w.data()));
+  }
+
+  ff::arena_t<> arena{ 64 };
+  assert(arena.capacity() == 64);
+
+  for (size_t round = 0; round < 2; round++) {
+    const auto a = arena.alloc(3);
+    const auto b = arena.alloc(12);
+    const auto c = arena.alloc(1);
+
+    assert(a.size() == 3 && b.size() == 12 && c.size() == 1);
+    assert(ff::is_aligned<ff::ALIGNMENT>(a.data()));
+    assert(ff::is_aligned<ff::ALIGNMENT>(b.data()));
+    assert(ff::is_aligned<ff::ALIGNMENT>(c.data()));
+
+    // each buffer starts at next 64 -bytes boundary i.e. after 8 elements
+    assert(b.data() == a.data() + 8);
+    assert(c.data() == b.data() + 16);
+    assert(arena.size() == 25);
+
+    // 32 elements are needed, starting at 32nd one, while only 64 are there
+    assert(!arena.alloc(32).empty());
+    assert(arena.alloc(1).empty());
+
+    arena.reset();
+    assert(arena.size() == 0);
+  }
+
+  ff::aligned_vector_t<ff::ff_t> v(24);
+  const ff::aligned_span_t<ff::ff_t> s0{ v };
+  const ff::aligned_span_t<ff::ff_t, 32> s1 = s0.subspan(8, 16);
+
+  assert(s0.size() == 24 && s0.data() == v.data());
+  assert(s1.size() == 16 && s1.data() == v.data() + 8);
+}
+
+// Check that unaligned loads/ stores of SIMD ( or lane ) types round trip
+// elements kept at addresses which are not aligned to vector width
+inline void
+test_unaligned_loads()
+{
+  constexpr size_t L = rescue::BATCH_LANES;
+
+  alignas(32) ff::ff_t src[L + 1];
+  alignas(32) ff::ff_t dst[L + 1]{};
+  for (size_t i = 0; i < L + 1; i++) {
+    src[i] = ff::ff_t::random();
+  }
+
+  const auto a = rescue::lane_t::load_unaligned(src + 1);
+  a.store_unaligned(dst + 1);
+
+  assert(dst[0] == ff::ff_t::zero());
+  for (size_t i = 1; i < L + 1; i++) {
+    assert(dst[i] == src[i]);
+  }
+
+#if defined __AVX512F__
+
+  alignas(64) ff::ff_t src8[9];
+  alignas(64) ff::ff_t dst8[9]{};
+  for (size_t i = 0; i < 9; i++) {
+    src8[i] = ff::ff_t::random();
+  }
+
+  const auto b = ff::ff_avx512_t::load_unaligned(src8 + 1);
+  b.store_unaligned(dst8 + 1);
+
+  assert(dst8[0] == ff::ff_t::zero());
+  for (size_t i = 1; i < 9; i++) {
+    assert(dst8[i] == src8[i]);
+  }
+
+#endif
+}
+
+// Check that hashing input, which is not aligned to vector width, produces
+// same digest as hashing an aligned copy of it, and that batched permutation of
+// an aligned span matches permuting each state
+inline void
+test_unaligned_hash()
+{
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+  constexpr size_t W = rescue::STATE_WIDTH;
+
+  for (size_t n = 1; n <= 40; n++) {
+    ff::aligned_vector_t<ff::ff_t> buf(n + 1);
+    for (auto& v : buf) {
+      v = ff::ff_t::random();
+    }
+
+    ff::aligned_vector_t<ff::ff_t> copy(n);
+    std::memcpy(copy.data(), buf.data() + 1, n * sizeof(ff::ff_t));
+
+    ff::ff_t digest0[D];
+    ff::ff_t digest1[D];
+
+    rescue_prime::hash(buf.data() + 1, n, digest0);
+    rescue_prime::hash(copy.data(), n, digest1);
+
+    for (size_t i = 0; i < D; i++) {
+      assert(digest0[i] == digest1[i]);
+    }
+  }
+
+  for (size_t n = 0; n <= 9; n++) {
+    ff::arena_t<> arena{ n * W };
+    const auto states = arena.alloc(n * W);
+    assert(states.size() == n * W);
+
+    for (size_t i = 0; i < n * W; i++) {
+      states[i] = ff::ff_t::random();
+    }
+
+    ff::aligned_vector_t<ff::ff_t> expected(states.elms.begin(),
+                                            states.elms.end());
+    for (size_t i = 0; i < n; i++) {
+      rescue::permute(expected.data() + i * W);
+    }
+
+    rescue::permute_batch(states);
+    for (size_t i = 0; i < n * W; i++) {
+      assert(states[i] == expected[i]);
+    }
+  }
+}
+
+}
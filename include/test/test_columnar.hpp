@@ -0,0 +1,52 @@
+#pragma once
+#include "columnar.hpp"
+#include <cassert>
+#include <vector>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Check that hashing rows of a column-major matrix produces same digests as
+// hashing each row, using `rescue_prime::hash`, for matrices whose dimensions
+// are not multiple of rate, lanes or tile
+inline void
+test_hash_rows_columnar()
+{
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+  constexpr size_t T = rescue_prime::COLUMNAR_TILE_ROWS;
+
+  for (const size_t n_cols : { 1ul, 3ul, 8ul, 9ul, 16ul, 21ul }) {
+    for (const size_t n_rows : { 0ul, 1ul, 5ul, T - 1, T, 2 * T + 7 }) {
+      std::vector<std::vector<ff::ff_t>> matrix(n_cols);
+      std::vector<const ff::ff_t*> columns(n_cols);
+
+      for (size_t c = 0; c < n_cols; c++) {
+        matrix[c].resize(n_rows);
+        for (auto& v : matrix[c]) {
+          v = ff::ff_t::random();
+        }
+        columns[c] = matrix[c].data();
+      }
+
+      std::vector<ff::ff_t> digests(n_rows * D);
+      rescue_prime::hash_rows_columnar(
+        columns.data(), n_cols, n_rows, digests.data());
+
+      std::vector<ff::ff_t> row(n_cols);
+      ff::ff_t expected[D];
+
+      for (size_t r = 0; r < n_rows; r++) {
+        for (size_t c = 0; c < n_cols; c++) {
+          row[c] = matrix[c][r];
+        }
+
+        rescue_prime::hash(row.data(), n_cols, expected);
+        for (size_t d = 0; d < D; d++) {
+          assert(digests[r * D + d] == expected[d]);
+        }
+      }
+    }
+  }
+}
+
+}
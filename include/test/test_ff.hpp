@@ -61,7 +61,78 @@ test_field_ops()
     }
 
     assert(res == l);
+
+    // squaring, repeated squaring
+    const auto [hi, lo] = ff::full_mul_u64(a.v, b.v ^ a.v);
+    const auto [sqr_hi, sqr_lo] = ff::full_sqr_u64(b.v ^ a.v);
+    const auto [mul_hi, mul_lo] = ff::full_mul_u64(b.v ^ a.v, b.v ^ a.v);
+
+    assert(sqr_hi == mul_hi && sqr_lo == mul_lo);
+    assert(ff::ff_t{ ff::reduce128(hi, lo) } == a * ff::ff_t{ b.v ^ a.v });
+    assert(a.square() == a * a);
+    assert(a.square_n<5>() == (a ^ 32ul));
+  }
+
+  static_assert(ff::ff_t{ 3ul }.square_n<2>() == ff::ff_t{ 81ul });
+  static_assert((ff::ff_t{ ff::Q - 1ul }).square() == ff::ff_t::one());
+}
+
+// Test that all scalar multiplication and reduction kernels, available on
+// target ( see `FF_MUL` and `FF_REDUCE` ), compute same result, both on edge
+// values and randomly sampled 64 -bit unsigned integers
+template<const size_t rounds = 1024ul>
+void
+test_mul_kernels()
+{
+  static_assert(rounds > 0, "Round must not be = 0 !");
+
+  constexpr uint64_t edges[]{
+    0ul, 1ul, ff::EPSILON, ff::Q - 1ul, ff::Q, ff::Q + 1ul, UINT64_MAX - 1ul,
+    UINT64_MAX,
+  };
+  constexpr size_t edge_cnt = sizeof(edges) / sizeof(edges[0]);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (size_t i = 0; i < rounds + edge_cnt * edge_cnt; i++) {
+    const bool edge = i < edge_cnt * edge_cnt;
+    const uint64_t a = edge ? edges[i / edge_cnt] : gen();
+    const uint64_t b = edge ? edges[i % edge_cnt] : gen();
+
+    const auto expected = ff::full_mul_u64_schoolbook(a, b);
+    const auto [hi, lo] = expected;
+    const ff::ff_t res{ ff::reduce128_generic(hi, lo) };
+
+    const auto sqr = ff::full_mul_u64_schoolbook(a, a);
+
+    assert(ff::full_sqr_u64_schoolbook(a) == sqr);
+    assert(ff::full_mul_u64(a, b) == expected);
+    assert(ff::full_sqr_u64(a) == sqr);
+    assert(ff::ff_t{ ff::reduce128(hi, lo) } == res);
+
+#if __SIZEOF_INT128__ == 16
+    assert(ff::full_mul_u64_int128(a, b) == expected);
+#endif
+#if defined __x86_64__ && defined __BMI2__
+    assert(ff::full_mul_u64_mulx(a, b) == expected);
+#endif
+#if defined __x86_64__
+    assert(ff::ff_t{ ff::reduce128_adx(hi, lo) } == res);
+    assert(ff::ff_t{ ff::reduce128_adx(a, b) } ==
+           ff::ff_t{ ff::reduce128_generic(a, b) });
+#endif
   }
+
+  // kernels using intrinsics fall back to portable ones, when constant
+  // evaluated
+  constexpr auto prod = ff::full_mul_u64(ff::Q - 1ul, ff::Q - 1ul);
+  static_assert(ff::ff_t{ ff::reduce128(prod.first, prod.second) } ==
+                ff::ff_t::one());
+#if defined __x86_64__ && defined __BMI2__
+  static_assert(ff::full_mul_u64_mulx(UINT64_MAX, 3ul) ==
+                ff::full_mul_u64_schoolbook(UINT64_MAX, 3ul));
+#endif
 }
 
 #if defined __AVX2__
@@ -205,6 +276,64 @@ test_avx_mod_mul()
   }
 }
 
+// Ensure that vectorized ( using AVX2 ) squaring u64 -> u128 and modulo
+// squaring over Z_q are implemented correctly, by checking computed results
+// against scalar multiplication, where operands also include edge cases, which
+// exercise carry/ borrow folding of Goldilocks specific reduction.
+template<const size_t rounds = 256ul>
+void
+test_avx_mod_sqr()
+{
+  static_assert(rounds > 0, "Round must not be = 0 !");
+
+  constexpr uint64_t edges[]{
+    0ul,          1ul,         2ul,         ff::EPSILON, ff::EPSILON + 1ul,
+    1ul << 63,    ff::Q - 1ul, ff::Q - 2ul, ff::Q - ff::EPSILON,
+  };
+  constexpr size_t ecnt = sizeof(edges) / sizeof(edges[0]);
+
+  alignas(32) ff::ff_t arr0[4 * rounds];
+  alignas(32) ff::ff_t arr1[4 * rounds];
+  alignas(32) ff::ff_t computed_sqr[4 * rounds];
+  alignas(32) ff::ff_t computed_mul[4 * rounds];
+  alignas(32) ff::ff_t computed_sqr_n[4 * rounds];
+  alignas(32) uint64_t computed_hi[4 * rounds];
+  alignas(32) uint64_t computed_lo[4 * rounds];
+
+  // generate some random Z_q elements, with edge cases mixed in
+  for (size_t i = 0; i < 4 * rounds; i++) {
+    arr0[i] = i < ecnt ? ff::ff_t{ edges[i] } : ff::ff_t::random();
+    arr1[i] = ff::ff_t{ edges[i % ecnt] };
+  }
+
+  // compute squares and products, using AVX2 implementation
+  for (size_t i = 0; i < rounds; i++) {
+    const size_t off = i * 4;
+
+    const ff::ff_avx_t a{ arr0 + off };
+    const ff::ff_avx_t b{ arr1 + off };
+
+    a.square().store(computed_sqr + off);
+    (a * b).store(computed_mul + off);
+    a.square_n<3>().store(computed_sqr_n + off);
+
+    const auto [hi, lo] = ff::full_sqr_u64x4(a.v);
+    _mm256_store_si256((__m256i*)(computed_hi + off), hi);
+    _mm256_store_si256((__m256i*)(computed_lo + off), lo);
+  }
+
+  // finally ensure both implementations produce same result.
+  for (size_t i = 0; i < 4 * rounds; i++) {
+    const auto [hi, lo] = ff::full_mul_u64(arr0[i].v, arr0[i].v);
+
+    assert(computed_hi[i] == hi);
+    assert(computed_lo[i] == lo);
+    assert(computed_sqr[i] == arr0[i] * arr0[i]);
+    assert(computed_sqr_n[i] == (arr0[i] ^ 8ul));
+    assert(computed_mul[i] == arr0[i] * arr1[i]);
+  }
+}
+
 #endif
 
 #if defined __ARM_NEON
@@ -349,6 +478,64 @@ test_neon_mod_mul()
   }
 }
 
+// Ensure that vectorized ( using NEON ) squaring u64 -> u128 and modulo
+// squaring over Z_q are implemented correctly, by checking computed results
+// against scalar multiplication, where operands also include edge cases, which
+// exercise carry/ borrow folding of Goldilocks specific reduction.
+template<const size_t rounds = 256ul>
+void
+test_neon_mod_sqr()
+{
+  static_assert(rounds > 0, "Round must not be = 0 !");
+
+  constexpr uint64_t edges[]{
+    0ul,          1ul,         2ul,         ff::EPSILON, ff::EPSILON + 1ul,
+    1ul << 63,    ff::Q - 1ul, ff::Q - 2ul, ff::Q - ff::EPSILON,
+  };
+  constexpr size_t ecnt = sizeof(edges) / sizeof(edges[0]);
+
+  ff::ff_t arr0[2 * rounds];
+  ff::ff_t arr1[2 * rounds];
+  ff::ff_t computed_sqr[2 * rounds];
+  ff::ff_t computed_mul[2 * rounds];
+  ff::ff_t computed_sqr_n[2 * rounds];
+  uint64_t computed_hi[2 * rounds];
+  uint64_t computed_lo[2 * rounds];
+
+  // generate some random Z_q elements, with edge cases mixed in
+  for (size_t i = 0; i < 2 * rounds; i++) {
+    arr0[i] = i < ecnt ? ff::ff_t{ edges[i] } : ff::ff_t::random();
+    arr1[i] = ff::ff_t{ edges[i % ecnt] };
+  }
+
+  // compute squares and products, using NEON implementation
+  for (size_t i = 0; i < rounds; i++) {
+    const size_t off = i * 2;
+
+    const ff::ff_neon_t a{ arr0 + off };
+    const ff::ff_neon_t b{ arr1 + off };
+
+    a.square().store(computed_sqr + off);
+    (a * b).store(computed_mul + off);
+    a.square_n<3>().store(computed_sqr_n + off);
+
+    const auto [hi, lo] = ff::full_sqr_u64x2(a.v);
+    vst1q_u64(computed_hi + off, hi);
+    vst1q_u64(computed_lo + off, lo);
+  }
+
+  // finally ensure both implementations produce same result.
+  for (size_t i = 0; i < 2 * rounds; i++) {
+    const auto [hi, lo] = ff::full_mul_u64(arr0[i].v, arr0[i].v);
+
+    assert(computed_hi[i] == hi);
+    assert(computed_lo[i] == lo);
+    assert(computed_sqr[i] == arr0[i] * arr0[i]);
+    assert(computed_sqr_n[i] == (arr0[i] ^ 8ul));
+    assert(computed_mul[i] == arr0[i] * arr1[i]);
+  }
+}
+
 #endif
 
 #if defined __AVX512F__
@@ -492,6 +679,64 @@ test_avx512_mod_mul()
   }
 }
 
+// Ensure that vectorized ( using AVX512 ) squaring u64 -> u128 and modulo
+// squaring over Z_q are implemented correctly, by checking computed results
+// against scalar multiplication, where operands also include edge cases, which
+// exercise carry/ borrow folding of Goldilocks specific reduction.
+template<const size_t rounds = 256ul>
+void
+test_avx512_mod_sqr()
+{
+  static_assert(rounds > 0, "Round must not be = 0 !");
+
+  constexpr uint64_t edges[]{
+    0ul,          1ul,         2ul,         ff::EPSILON, ff::EPSILON + 1ul,
+    1ul << 63,    ff::Q - 1ul, ff::Q - 2ul, ff::Q - ff::EPSILON,
+  };
+  constexpr size_t ecnt = sizeof(edges) / sizeof(edges[0]);
+
+  alignas(64) ff::ff_t arr0[8 * rounds];
+  alignas(64) ff::ff_t arr1[8 * rounds];
+  alignas(64) ff::ff_t computed_sqr[8 * rounds];
+  alignas(64) ff::ff_t computed_mul[8 * rounds];
+  alignas(64) ff::ff_t computed_sqr_n[8 * rounds];
+  alignas(64) uint64_t computed_hi[8 * rounds];
+  alignas(64) uint64_t computed_lo[8 * rounds];
+
+  // generate some random Z_q elements, with edge cases mixed in
+  for (size_t i = 0; i < 8 * rounds; i++) {
+    arr0[i] = i < ecnt ? ff::ff_t{ edges[i] } : ff::ff_t::random();
+    arr1[i] = ff::ff_t{ edges[i % ecnt] };
+  }
+
+  // compute squares and products, using AVX512 implementation
+  for (size_t i = 0; i < rounds; i++) {
+    const size_t off = i * 8;
+
+    const ff::ff_avx512_t a{ arr0 + off };
+    const ff::ff_avx512_t b{ arr1 + off };
+
+    a.square().store(computed_sqr + off);
+    (a * b).store(computed_mul + off);
+    a.square_n<3>().store(computed_sqr_n + off);
+
+    const auto [hi, lo] = ff::full_sqr_u64x8(a.v);
+    _mm512_store_epi64(computed_hi + off, hi);
+    _mm512_store_epi64(computed_lo + off, lo);
+  }
+
+  // finally ensure both implementations produce same result.
+  for (size_t i = 0; i < 8 * rounds; i++) {
+    const auto [hi, lo] = ff::full_mul_u64(arr0[i].v, arr0[i].v);
+
+    assert(computed_hi[i] == hi);
+    assert(computed_lo[i] == lo);
+    assert(computed_sqr[i] == arr0[i] * arr0[i]);
+    assert(computed_sqr_n[i] == (arr0[i] ^ 8ul));
+    assert(computed_mul[i] == arr0[i] * arr1[i]);
+  }
+}
+
 #endif
 
 }
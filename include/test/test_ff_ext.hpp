@@ -0,0 +1,170 @@
+#pragma once
+#include "ff_ext.hpp"
+#include "rescue_prime.hpp"
+#include <cassert>
+#include <vector>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Defining polynomials hold at compile-time, for φ and its conjugates, which
+// are used as Frobenius constants of cubic extension
+static_assert(ff::FROB1_PHI * ff::FROB1_PHI2 ==
+              ff::FROB1_PHI + ff::ff3_t::one());
+static_assert(ff::FROB2_PHI * ff::FROB2_PHI2 ==
+              ff::FROB2_PHI + ff::ff3_t::one());
+static_assert((ff::ff2_t{ 0ul, 1ul } ^ ff::Q) == ff::ff2_t{ 1ul, ff::Q - 1ul });
+
+// Test functional correctness of quadratic extension field arithmetic, by
+// checking Karatsuba multiplication against schoolbook multiplication and
+// Frobenius map against exponentiation, on randomly sampled elements
+template<const size_t rounds = 256ul>
+void
+test_ff2_ops()
+{
+  static_assert(rounds > 0, "Round must not be = 0 !");
+
+  for (size_t i = 0; i < rounds; i++) {
+    const auto a = ff::ff2_t::random();
+    const auto b = ff::ff2_t::random();
+
+    // (a0 + a1φ)(b0 + b1φ) | φ^2 = φ - 2
+    const auto d0 = a.c[0] * b.c[0];
+    const auto d1 = a.c[0] * b.c[1] + a.c[1] * b.c[0];
+    const auto d2 = a.c[1] * b.c[1];
+    const ff::ff2_t expected{ d0 - (d2 + d2), d1 + d2 };
+
+    assert(a * b == expected);
+    assert(a.square() == a * a);
+    assert((a + b) - b == a);
+    assert(a + (-a) == ff::ff2_t::zero());
+
+    assert(a.frobenius() == (a ^ ff::Q));
+    assert((a * b).frobenius() == a.frobenius() * b.frobenius());
+    assert(a * a.frobenius() == ff::ff2_t{ a.norm() });
+
+    if (a == ff::ff2_t::zero()) {
+      assert(a.inv() == ff::ff2_t::zero());
+    } else {
+      assert(a * a.inv() == ff::ff2_t::one());
+      assert((b / a) * a == b);
+    }
+  }
+}
+
+// Test functional correctness of cubic extension field arithmetic, by checking
+// Karatsuba multiplication against schoolbook multiplication and Frobenius map
+// against exponentiation, on randomly sampled elements
+template<const size_t rounds = 256ul>
+void
+test_ff3_ops()
+{
+  static_assert(rounds > 0, "Round must not be = 0 !");
+
+  for (size_t i = 0; i < rounds; i++) {
+    const auto a = ff::ff3_t::random();
+    const auto b = ff::ff3_t::random();
+
+    // (a0 + a1φ + a2φ^2)(b0 + b1φ + b2φ^2) | φ^3 = φ + 1, φ^4 = φ^2 + φ
+    const auto d0 = a.c[0] * b.c[0];
+    const auto d1 = a.c[0] * b.c[1] + a.c[1] * b.c[0];
+    const auto d2 = a.c[0] * b.c[2] + a.c[1] * b.c[1] + a.c[2] * b.c[0];
+    const auto d3 = a.c[1] * b.c[2] + a.c[2] * b.c[1];
+    const auto d4 = a.c[2] * b.c[2];
+    const ff::ff3_t expected{ d0 + d3, d1 + d3 + d4, d2 + d4 };
+
+    assert(a * b == expected);
+    assert(a.square() == a * a);
+    assert((a + b) - b == a);
+    assert(a + (-a) == ff::ff3_t::zero());
+
+    assert(a.frobenius<0>() == a);
+    assert(a.frobenius<1>() == (a ^ ff::Q));
+    assert(a.frobenius<2>() == ((a ^ ff::Q) ^ ff::Q));
+    assert((a * b).frobenius<1>() == a.frobenius<1>() * b.frobenius<1>());
+
+    const auto n = a * a.frobenius<1>() * a.frobenius<2>();
+    assert(n == ff::ff3_t{ a.norm() });
+
+    if (a == ff::ff3_t::zero()) {
+      assert(a.inv() == ff::ff3_t::zero());
+    } else {
+      assert(a * a.inv() == ff::ff3_t::one());
+      assert((b / a) * a == b);
+    }
+  }
+}
+
+// Test that batched extension field kernels compute same result as scalar
+// arithmetic, for array lengths which are not multiple of SIMD lanes, and when
+// output aliases input
+template<typename E, const size_t max_n = 19ul>
+void
+test_ext_many()
+{
+  for (size_t n = 0; n <= max_n; n++) {
+    std::vector<E> a(n), b(n), c(n);
+
+    for (size_t i = 0; i < n; i++) {
+      a[i] = E::random();
+      b[i] = E::random();
+    }
+
+    ff::add_many(a.data(), b.data(), c.data(), n);
+    for (size_t i = 0; i < n; i++) {
+      assert(c[i] == a[i] + b[i]);
+    }
+
+    ff::sub_many(a.data(), b.data(), c.data(), n);
+    for (size_t i = 0; i < n; i++) {
+      assert(c[i] == a[i] - b[i]);
+    }
+
+    ff::mul_many(a.data(), b.data(), c.data(), n);
+    for (size_t i = 0; i < n; i++) {
+      assert(c[i] == a[i] * b[i]);
+    }
+
+    ff::square_many(a.data(), c.data(), n);
+    for (size_t i = 0; i < n; i++) {
+      assert(c[i] == a[i].square());
+    }
+
+    std::vector<E> d = a;
+    ff::mul_many(d.data(), b.data(), d.data(), n);
+    for (size_t i = 0; i < n; i++) {
+      assert(d[i] == a[i] * b[i]);
+    }
+  }
+}
+
+// Test that hashing extension field elements produces same digest as hashing
+// their base field coefficients, laid out one after another
+template<typename E, const size_t max_n = 8ul>
+void
+test_ext_hash()
+{
+  for (size_t n = 1; n <= max_n; n++) {
+    std::vector<E> elms(n);
+    std::vector<ff::ff_t> coeffs;
+
+    for (size_t i = 0; i < n; i++) {
+      elms[i] = E::random();
+      for (size_t k = 0; k < E::DEGREE; k++) {
+        coeffs.push_back(elms[i].c[k]);
+      }
+    }
+
+    ff::ff_t digest0[rescue::DIGEST_WIDTH];
+    ff::ff_t digest1[rescue::DIGEST_WIDTH];
+
+    rescue_prime::hash(elms.data(), n, digest0);
+    rescue_prime::hash(coeffs.data(), coeffs.size(), digest1);
+
+    for (size_t i = 0; i < rescue::DIGEST_WIDTH; i++) {
+      assert(digest0[i] == digest1[i]);
+    }
+  }
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "hasher.hpp"
+#include <cassert>
+#include <vector>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Check that incremental hasher, resumed from a midstate, either one suffix at
+// a time or for a batch of suffixes, produces same digest as hashing prefix ||
+// suffix using `rescue_prime::hash`
+inline void
+test_midstate()
+{
+  constexpr size_t n = 6;
+
+  for (size_t plen = 0; plen <= 17; plen++) {
+    for (size_t slen = 0; slen <= 17; slen++) {
+      std::vector<ff::ff_t> prefix(plen);
+      std::vector<ff::ff_t> suffixes(n * slen);
+
+      for (auto& v : prefix) {
+        v = ff::ff_t::random();
+      }
+      for (auto& v : suffixes) {
+        v = ff::ff_t::random();
+      }
+
+      rescue_prime::hasher_t mid{ plen + slen };
+      mid.absorb(prefix.data(), plen);
+
+      std::vector<ff::ff_t> batched(n * rescue::DIGEST_WIDTH);
+      const auto* sfx = suffixes.data();
+      rescue_prime::finalize_many(mid, sfx, slen, n, batched.data());
+
+      for (size_t i = 0; i < n; i++) {
+        std::vector<ff::ff_t> msg(prefix);
+        msg.insert(msg.end(),
+                   suffixes.begin() + i * slen,
+                   suffixes.begin() + (i + 1) * slen);
+
+        rescue_prime::digest_t expected;
+        rescue_prime::hash(msg.data(), msg.size(), expected.data());
+
+        auto hasher = mid;
+        hasher.absorb(suffixes.data() + i * slen, slen);
+
+        rescue_prime::digest_t computed;
+        hasher.finalize(computed.data());
+
+        assert(computed == expected);
+        for (size_t j = 0; j < rescue::DIGEST_WIDTH; j++) {
+          assert(batched[i * rescue::DIGEST_WIDTH + j] == expected[j]);
+        }
+      }
+    }
+  }
+}
+
+}
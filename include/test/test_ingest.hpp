@@ -0,0 +1,171 @@
+#pragma once
+#include "ingest.hpp"
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Writes raw 64 -bit words to file at given path, truncating it
+static inline void
+write_words(const std::string& path, const std::vector<uint64_t>& words)
+{
+  std::ofstream f{ path, std::ios::binary | std::ios::trunc };
+  f.write(reinterpret_cast<const char*>(words.data()),
+          static_cast<std::streamsize>(words.size() * sizeof(uint64_t)));
+}
+
+// Check that elements ingested from files and pipes, in blocks of various
+// sizes, using both io_uring and reader thread backends, hash to same digest(s)
+// as hashing them in memory, that non-canonical values are reduced, that
+// inputs of wrong length are rejected and that reader can be destroyed, while
+// waiting on an idle pipe
+inline void
+test_ingest()
+{
+  using ingest::backend_t;
+
+  const auto path =
+    (std::filesystem::temp_directory_path() / "rphash_test_ingest.bin")
+      .string();
+
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+
+  for (const auto backend : { backend_t::automatic, backend_t::thread }) {
+    for (const size_t n : { 1ul, 7ul, 8ul, 9ul, 100ul, 1000ul }) {
+      std::vector<uint64_t> words(n);
+      std::vector<ff::ff_t> elms(n);
+      for (size_t i = 0; i < n; i++) {
+        // every 7th value is not in canonical form
+        words[i] = (i % 7 == 0) ? ff::Q + i : ff::ff_t::random().v;
+        elms[i] = ff::ff_t{ words[i] };
+      }
+      write_words(path, words);
+
+      ff::ff_t expected[D];
+      rescue_prime::hash(elms.data(), n, expected);
+
+      ff::ff_t computed[D];
+      assert(ingest::hash_file(path, computed, backend));
+      assert(std::equal(computed, computed + D, expected));
+
+      for (const size_t block : { 1ul, 5ul, 8ul, 64ul }) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        ingest::reader_t rd{ fd, backend, block };
+
+        // rows of 3 elements, with incomplete last row, when n % 3 != 0
+        std::vector<rescue_prime::digest_t> digests;
+        const bool res = ingest::hash_rows_stream(rd, 3, digests);
+        ::close(fd);
+
+        assert(res == (n % 3 == 0));
+        assert(digests.size() == n / 3);
+        for (size_t r = 0; r < n / 3; r++) {
+          ff::ff_t row_digest[D];
+          rescue_prime::hash(elms.data() + r * 3, 3, row_digest);
+          assert(std::equal(row_digest, row_digest + D, digests[r].data()));
+        }
+      }
+
+      // elements written to a pipe in uneven pieces, by another thread
+      int fds[2];
+      assert(::pipe(fds) == 0);
+
+      std::thread writer([&]() {
+        const auto* src = reinterpret_cast<const uint8_t*>(words.data());
+        size_t left = n * sizeof(uint64_t);
+
+        for (size_t piece = 3; left > 0; piece += 11) {
+          const size_t len = std::min(piece, left);
+          const auto ret = ::write(fds[1], src, len);
+          assert(ret > 0);
+
+          src += ret;
+          left -= static_cast<size_t>(ret);
+        }
+        ::close(fds[1]);
+      });
+
+      {
+        ingest::reader_t rd{ fds[0], backend, 16 };
+        assert(ingest::hash_stream(rd, n, computed));
+        assert(std::equal(computed, computed + D, expected));
+      }
+
+      writer.join();
+      ::close(fds[0]);
+
+      // wrong element count
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      {
+        ingest::reader_t rd{ fd, backend, 4 };
+        assert(!ingest::hash_stream(rd, n + 1, computed));
+      }
+      ::close(fd);
+    }
+
+    // length not multiple of 8 -bytes
+    {
+      std::ofstream f{ path, std::ios::binary | std::ios::trunc };
+      f.write("0123456789abc", 13);
+    }
+
+    ff::ff_t computed[D];
+    assert(!ingest::hash_file(path, computed, backend));
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    {
+      ingest::reader_t rd{ fd, backend, 4 };
+      std::vector<rescue_prime::digest_t> digests;
+      assert(!ingest::hash_rows_stream(rd, 1, digests));
+      assert(!rd.ok());
+    }
+    ::close(fd);
+
+    // rows of no elements
+    {
+      write_words(path, { 1ul, 2ul });
+
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      ingest::reader_t rd{ fd, backend, 4 };
+      std::vector<rescue_prime::digest_t> digests;
+      assert(!ingest::hash_rows_stream(rd, 0, digests));
+      assert(digests.empty());
+      ::close(fd);
+    }
+
+    // reader destroyed, while waiting on a pipe, whose writer is idle
+    {
+      int fds[2];
+      assert(::pipe(fds) == 0);
+
+      const uint64_t words[4]{ 1ul, 2ul, 3ul, 4ul };
+      assert(::write(fds[1], words, sizeof(words)) == sizeof(words));
+
+      {
+        ingest::reader_t rd{ fds[0], backend, 4 };
+        const auto blk = rd.next();
+        assert(blk.size() == 4);
+      }
+
+      ::close(fds[0]);
+      ::close(fds[1]);
+    }
+  }
+
+#if INGEST_IO_URING
+  {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    ingest::reader_t rd{ fd, backend_t::thread };
+    assert(rd.backend() == backend_t::thread);
+    ::close(fd);
+  }
+#endif
+
+  std::filesystem::remove(path);
+}
+
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include "instrument.hpp"
+#include "parallel.hpp"
+#include "rescue_prime.hpp"
+#include "tree_hash.hpp"
+#include <cassert>
+#include <thread>
+#include <vector>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Check that instrumentation counters ( when enabled ) count hashing calls,
+// absorbed elements, permutations and their stages, executed by calling thread
+// only, while they stay zero when instrumentation is disabled
+inline void
+test_instrumentation()
+{
+  using instrument::counter_t;
+
+  constexpr size_t ilen = 20;
+  constexpr size_t npairs = 5;
+
+  std::vector<ff::ff_t> in(ilen);
+  std::vector<ff::ff_t> pairs(npairs * rescue::RATE);
+  for (auto& v : in) {
+    v = ff::ff_t::random();
+  }
+  for (auto& v : pairs) {
+    v = ff::ff_t::random();
+  }
+
+  ff::ff_t out[rescue::DIGEST_WIDTH];
+  std::vector<ff::ff_t> outs(npairs * rescue::DIGEST_WIDTH);
+
+  const instrument::scope_t scope;
+
+  rescue_prime::hash(in.data(), ilen, out);
+  rescue_prime::merge(pairs.data(), pairs.data() + rescue::DIGEST_WIDTH, out);
+  rescue_prime::merge_many(pairs.data(), npairs, outs.data());
+  const auto inv = in[0].inv();
+  assert(in[0] * inv == ff::ff_t::one());
+
+  // events on other threads must not be counted on this one
+  std::thread t([&]() { rescue_prime::hash(in.data(), ilen, out); });
+  t.join();
+
+  const auto d = scope.delta();
+
+  if constexpr (instrument::ENABLED) {
+    constexpr size_t perms = 3 + 1 + npairs;
+
+    assert(d[counter_t::hash] == 1);
+    assert(d[counter_t::merge] == 1 + npairs);
+    assert(d[counter_t::absorbed] == ilen + rescue::RATE * (1 + npairs));
+    assert(d[counter_t::permutations] == perms);
+    assert(d[counter_t::permute_batch] >= 1);
+    assert(d[counter_t::sbox] == rescue::ROUNDS * perms);
+    assert(d[counter_t::inv_sbox] == rescue::ROUNDS * perms);
+    assert(d[counter_t::mds] == 2 * rescue::ROUNDS * perms);
+    assert(d[counter_t::ff_inv] == 1);
+    assert(d[counter_t::ff_exp] == 1);
+    assert(d[counter_t::ff_mul] >= 128);
+
+    instrument::reset();
+    assert(instrument::snapshot()[counter_t::permutations] == 0);
+  } else {
+    for (const auto v : d.counts) {
+      assert(v == 0);
+    }
+  }
+}
+
+// Check that events counted by tasks of parallel hashing routines, executed on
+// workers of a pool, are attributed to thread submitting the job, so that
+// same counts are reported, no matter how many threads are used
+inline void
+test_instrumentation_parallel()
+{
+  using instrument::counter_t;
+
+  constexpr size_t ilen = 8 * rescue_prime::TREE_CHUNK_LEN;
+  constexpr size_t npairs = 37;
+
+  std::vector<ff::ff_t> in(ilen);
+  for (auto& v : in) {
+    v = ff::ff_t::random();
+  }
+
+  parallel::pool_t pool{ 3 };
+  ff::ff_t out[rescue::DIGEST_WIDTH];
+  std::vector<ff::ff_t> outs(npairs * rescue::DIGEST_WIDTH);
+
+  auto count = [&](const size_t nthreads) {
+    const instrument::scope_t scope;
+
+    rescue_prime::tree_hash(in.data(), ilen, out, nthreads, &pool);
+    rescue_prime::merge_many(in.data(), npairs, outs.data(), nthreads, &pool);
+
+    // nested jobs, whose tasks submit jobs to same pool
+    pool.run(nthreads, [&](const size_t i) {
+      ff::ff_t digests[4 * rescue::DIGEST_WIDTH];
+      rescue_prime::merge_many(
+        in.data() + i * 32, 4, digests, nthreads, &pool);
+    });
+
+    return scope.delta();
+  };
+
+  const auto serial = count(1);
+  const auto threaded = count(4);
+
+  if constexpr (instrument::ENABLED) {
+    for (const auto c : { counter_t::permutations,
+                          counter_t::merge,
+                          counter_t::absorbed,
+                          counter_t::sbox,
+                          counter_t::inv_sbox,
+                          counter_t::mds }) {
+      assert(threaded[c] > 0);
+    }
+    // nested job runs one more task per extra thread, merging 4 pairs each
+    constexpr size_t extra = 3 * 4;
+
+    assert(threaded[counter_t::permutations] ==
+           serial[counter_t::permutations] + extra);
+    assert(threaded[counter_t::merge] == serial[counter_t::merge] + extra);
+    assert(threaded[counter_t::absorbed] ==
+           serial[counter_t::absorbed] + extra * rescue::RATE);
+    assert(threaded[counter_t::mds] ==
+           serial[counter_t::mds] + extra * 2 * rescue::ROUNDS);
+  } else {
+    for (const auto v : threaded.counts) {
+      assert(v == 0);
+    }
+  }
+}
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "merkle_file.hpp"
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Check that Merkle tree file, written by streaming builder, from leaves
+// appended in batches of uneven size, holds same levels as Merkle tree built
+// in memory, that authentication paths read from memory-mapped file verify,
+// while tampered ones don't, that out of range queries are rejected and that
+// incomplete or corrupted files are rejected
+inline void
+test_merkle_file()
+{
+  const auto path =
+    (std::filesystem::temp_directory_path() / "rphash_test_tree.bin").string();
+
+  constexpr size_t C = merkle::TREE_FILE_CHUNK;
+
+  for (const size_t n : { 1ul, 2ul, 8ul, C, 4 * C }) {
+    std::vector<std::vector<merkle::digest_t>> levels(1);
+    for (size_t i = 0; i < n; i++) {
+      merkle::digest_t leaf;
+      for (auto& v : leaf) {
+        v = ff::ff_t::random();
+      }
+      levels[0].push_back(leaf);
+    }
+    while (levels.back().size() > 1) {
+      const auto& lvl = levels.back();
+
+      std::vector<merkle::digest_t> next;
+      for (size_t i = 0; i < lvl.size(); i += 2) {
+        next.push_back(rescue_prime::merge(lvl[i], lvl[i + 1]));
+      }
+      levels.push_back(std::move(next));
+    }
+
+    {
+      merkle::tree_file_builder_t builder{ path, n, 2 };
+      assert(builder.ok());
+
+      for (size_t off = 0, batch = 1; off < n; off += batch, batch += 37) {
+        batch = std::min(batch, n - off);
+        builder.append(levels[0].data() + off, batch);
+      }
+
+      const auto root = builder.finish();
+      assert(root.has_value() && *root == levels.back()[0]);
+    }
+
+    const auto file = merkle::tree_file_t::open(path);
+    assert(file.has_value());
+    assert(file->leaf_count == n);
+    assert(file->depth == levels.size() - 1);
+    assert(file->root() == levels.back()[0]);
+
+    for (size_t h = 0; h < levels.size(); h++) {
+      for (size_t i = 0; i < levels[h].size(); i++) {
+        assert(file->node(h, i) == levels[h][i]);
+      }
+    }
+
+    // out of range queries are rejected
+    assert(!file->node(0, n).has_value());
+    assert(!file->node(file->depth + 1, 0).has_value());
+    assert(!file->leaf(n).has_value());
+    assert(!file->path(n).has_value());
+    assert(!file->path(~0ul).has_value());
+
+    for (size_t k = 0; k < 16; k++) {
+      const uint64_t idx = (k * 2654435761ul) % n;
+
+      auto auth = *file->path(idx);
+      assert(auth.size() == file->depth);
+
+      const auto root = file->root();
+      const auto leaf = *file->leaf(idx);
+
+      using tree_t = merkle::tree_file_t;
+      assert(tree_t::verify(root, idx, leaf, auth));
+      assert(!tree_t::verify(root, idx + n, leaf, auth));
+
+      if (!auth.empty()) {
+        auth[0][0] = auth[0][0] + ff::ff_t::one();
+        assert(!tree_t::verify(root, idx, leaf, auth));
+      }
+    }
+  }
+
+  // builder not given all leaves
+  {
+    merkle::tree_file_builder_t builder{ path, 4 };
+    const merkle::digest_t leaf{};
+    builder.append(&leaf, 1);
+
+    assert(!builder.finish().has_value());
+    assert(!merkle::tree_file_t::open(path).has_value());
+  }
+
+  // truncated file
+  {
+    merkle::tree_file_builder_t builder{ path, 4 };
+    const merkle::digest_t leaves[4]{};
+    builder.append(leaves, 4);
+    assert(builder.finish().has_value());
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    assert(!merkle::tree_file_t::open(path).has_value());
+  }
+
+  assert(!merkle::tree_file_t::open(path + ".missing").has_value());
+  std::filesystem::remove(path);
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "merkle_mountain_range.hpp"
+#include "test_sparse_merkle_tree.hpp"
+#include <cassert>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Check that Merkle Mountain Range accumulator produces same nodes, no matter
+// whether leaves are appended one by one or in batches, that a mountain of 2^k
+// leaves has the root of the equivalent Merkle tree and that inclusion proofs
+// of all leaves are verified.
+inline void
+test_mmr()
+{
+  constexpr size_t n = 77;
+
+  std::vector<rescue_prime::digest_t> leaves(n);
+  for (auto& leaf : leaves) {
+    leaf = random_digest();
+  }
+
+  merkle::mountain_range_t mmr0, mmr1;
+  assert(mmr0.root() == merkle::mountain_range_t::bag_peaks(0, {}));
+
+  constexpr size_t batches[]{ 1, 2, 5, 8, 16, 0, 13, 32 };
+  size_t off = 0;
+
+  for (const size_t batch : batches) {
+    for (size_t i = 0; i < batch; i++) {
+      mmr0.append(leaves[off + i]);
+    }
+    mmr1.append(leaves.data() + off, batch);
+    off += batch;
+
+    assert(mmr0.leaf_count() == off);
+    assert(mmr0.levels == mmr1.levels);
+    assert(mmr0.root() == mmr1.root());
+    assert(mmr0.peaks().size() == static_cast<size_t>(std::popcount(off)));
+
+    const auto root = mmr1.root();
+    for (size_t i = 0; i < off; i++) {
+      const auto proof = mmr1.prove(i);
+      assert(merkle::mountain_range_t::verify(root, leaves[i], proof));
+      assert(!merkle::mountain_range_t::verify(root, random_digest(), proof));
+
+      auto forged = proof;
+      forged.leaf_count++;
+      assert(!merkle::mountain_range_t::verify(root, leaves[i], forged));
+    }
+  }
+
+  // first 64 leaves form a single mountain
+  auto level = std::vector(leaves.begin(), leaves.begin() + 64);
+  while (level.size() > 1) {
+    for (size_t i = 0; i < (level.size() >> 1); i++) {
+      level[i] = rescue_prime::merge(level[2 * i], level[2 * i + 1]);
+    }
+    level.resize(level.size() >> 1);
+  }
+  assert(mmr0.peaks()[0] == level[0]);
+
+  // batches of uneven size, after which some of the higher levels don't grow
+  constexpr size_t uneven[][3]{ { 2, 3, 0 }, { 1, 1, 0 }, { 3, 1, 2 },
+                                { 4, 3, 1 }, { 7, 2, 6 } };
+
+  for (const auto& seq : uneven) {
+    merkle::mountain_range_t one, many;
+    size_t cnt = 0;
+
+    for (const size_t batch : seq) {
+      for (size_t i = 0; i < batch; i++) {
+        one.append(leaves[cnt + i]);
+      }
+      many.append(leaves.data() + cnt, batch);
+      cnt += batch;
+
+      assert(one.levels == many.levels);
+      assert(one.root() == many.root());
+    }
+  }
+}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "merkle_stream.hpp"
+#include <cassert>
+#include <vector>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Computes root of binary Merkle tree, level by level, keeping all nodes in
+// memory, where last node of a level with odd number of nodes is promoted
+static inline merkle::digest_t
+merkle_root_reference(std::vector<merkle::digest_t> level)
+{
+  while (level.size() > 1) {
+    std::vector<merkle::digest_t> next;
+    for (size_t i = 0; i + 1 < level.size(); i += 2) {
+      next.push_back(rescue_prime::merge(level[i], level[i + 1]));
+    }
+    if (level.size() & 1ul) {
+      next.push_back(level.back());
+    }
+    level = std::move(next);
+  }
+
+  return level[0];
+}
+
+// Check that streaming Merkle tree builder computes same root as building the
+// tree level by level, in memory, no matter whether leaves are appended in
+// batches, from iterators or produced on another thread, and that builder can
+// be reused after finishing a tree
+inline void
+test_merkle_stream()
+{
+  constexpr size_t C = merkle::STREAM_CHUNK;
+  constexpr size_t counts[]{ 1, 2, 3, 5, 8, C - 1, C, C + 1, 2 * C, 3 * C + 5 };
+
+  merkle::stream_builder_t reused;
+
+  for (const size_t n : counts) {
+    std::vector<merkle::digest_t> leaves(n);
+    for (auto& leaf : leaves) {
+      for (auto& v : leaf) {
+        v = ff::ff_t::random();
+      }
+    }
+
+    const auto expected = merkle_root_reference(leaves);
+
+    for (size_t off = 0, batch = 1; off < n; off += batch, batch += 129) {
+      batch = std::min(batch, n - off);
+      reused.append(leaves.data() + off, batch);
+    }
+    assert(reused.finish() == expected);
+
+    merkle::stream_builder_t builder{ 3 };
+    builder.append(leaves.begin(), leaves.end());
+    assert(builder.finish() == expected);
+
+    // producer hands out leaves in uneven batches
+    size_t produced = 0;
+    auto produce = [&](merkle::digest_t* const dst, const size_t cap) {
+      const size_t len = std::min({ cap, n - produced, 1 + produced % 700 });
+      std::copy_n(leaves.data() + produced, len, dst);
+
+      produced += len;
+      return len;
+    };
+    assert(merkle::build_pipelined(produce, 2) == expected);
+    assert(produced == n);
+  }
+}
+
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include "merkle_mountain_range.hpp"
+#include "parallel.hpp"
+#include "sparse_merkle_tree.hpp"
+#include "tree_hash.hpp"
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Check that thread pool executes each task of a job exactly once, for pools
+// with and without workers ( pinned or not ), when jobs are submitted from
+// within tasks and by many threads concurrently
+inline void
+test_thread_pool()
+{
+  parallel::pool_t pool0{ 0 };
+  parallel::pool_t pool3{ 3 };
+  parallel::pool_t pinned{ 2, true };
+
+  for (auto* pool : { &pool0, &pool3, &pinned }) {
+    for (size_t n = 0; n <= 17; n++) {
+      std::vector<std::atomic<size_t>> hits(n);
+      pool->run(n, [&](const size_t i) { hits[i].fetch_add(1); });
+
+      for (const auto& h : hits) {
+        assert(h.load() == 1);
+      }
+    }
+
+    // nested jobs, whose tasks submit jobs to same pool
+    std::vector<std::atomic<size_t>> hits(8 * 8);
+    pool->run(8, [&](const size_t i) {
+      pool->run(8, [&](const size_t j) { hits[i * 8 + j].fetch_add(1); });
+    });
+    for (const auto& h : hits) {
+      assert(h.load() == 1);
+    }
+  }
+
+  // many callers sharing same pool
+  std::atomic<size_t> total{ 0 };
+  std::vector<std::thread> callers;
+  for (size_t t = 0; t < 4; t++) {
+    callers.emplace_back([&]() {
+      for (size_t k = 0; k < 16; k++) {
+        pool3.run(5, [&](const size_t) { total.fetch_add(1); });
+      }
+    });
+  }
+  for (auto& t : callers) {
+    t.join();
+  }
+  assert(total.load() == 4 * 16 * 5);
+}
+
+// Check that sysfs lists of CPUs/ NUMA nodes are parsed, skipping blank or
+// malformed ranges ( say cpulist of a memory-only node ), and that NUMA
+// topology always has at least one node with CPUs
+inline void
+test_numa_nodes()
+{
+  using v_t = std::vector<int>;
+
+  const auto cpus = parallel::parse_ranges("0-3,8-11\n");
+  assert(cpus == (v_t{ 0, 1, 2, 3, 8, 9, 10, 11 }));
+  assert(parallel::parse_ranges("0,2\n") == (v_t{ 0, 2 }));
+  assert(parallel::parse_ranges("5") == (v_t{ 5 }));
+  assert(parallel::parse_ranges("\n").empty());
+  assert(parallel::parse_ranges("").empty());
+  assert(parallel::parse_ranges("1-,x,3-4z, 7 ,9") == (v_t{ 7, 9 }));
+
+  const auto nodes = parallel::numa_nodes();
+  assert(!nodes.empty());
+  for (const auto& node : nodes) {
+    assert(!node.empty());
+  }
+}
+
+// Check that parallel hashing routines produce same result, no matter whether
+// they are run on default pool or on a pool supplied by caller
+inline void
+test_caller_pool()
+{
+  constexpr size_t C = rescue_prime::TREE_CHUNK_LEN;
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+
+  parallel::pool_t pool{ 2 };
+
+  std::vector<ff::ff_t> in(5 * C + 3);
+  for (auto& v : in) {
+    v = ff::ff_t::random();
+  }
+
+  rescue_prime::digest_t digest0, digest1;
+  rescue_prime::tree_hash(in.data(), in.size(), digest0.data(), 1);
+  rescue_prime::tree_hash(in.data(), in.size(), digest1.data(), 3, &pool);
+  assert(digest0 == digest1);
+
+  constexpr size_t pairs = 37;
+  std::vector<ff::ff_t> out0(pairs * D), out1(pairs * D), out2(pairs * D);
+
+  rescue_prime::merge_many(in.data(), pairs, out0.data());
+  rescue_prime::merge_many(in.data(), pairs, out1.data(), 4);
+  rescue_prime::merge_many(in.data(), pairs, out2.data(), 3, &pool);
+  assert(out0 == out1);
+  assert(out0 == out2);
+
+  std::vector<merkle::digest_t> leaves(100);
+  for (size_t i = 0; i < leaves.size(); i++) {
+    std::copy_n(in.data() + i * D, D, leaves[i].data());
+  }
+
+  merkle::mountain_range_t mmr0, mmr1;
+  mmr0.append(leaves.data(), leaves.size());
+  mmr1.append(leaves.data(), leaves.size(), 3, &pool);
+  assert(mmr0.root() == mmr1.root());
+
+  std::vector<merkle::kv_t> kvs;
+  for (size_t i = 0; i < 64; i++) {
+    kvs.emplace_back(ff::ff_t::random(), leaves[i]);
+  }
+
+  merkle::sparse_merkle_tree_t<32> smt0, smt1;
+  smt0.update(kvs.data(), kvs.size(), 1);
+  smt1.update(kvs.data(), kvs.size(), 4, &pool);
+  assert(smt0.root() == smt1.root());
+}
+
+}
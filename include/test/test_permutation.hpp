@@ -1,6 +1,9 @@
 #pragma once
 #include "permutation.hpp"
+#include "permutation_batch.hpp"
+#include "rescue_prime.hpp"
 #include <cassert>
+#include <vector>
 
 // Test functional correctness of Rescue Prime implementation
 namespace test_rphash {
@@ -39,4 +42,63 @@ test_permutation()
   }
 }
 
+// Check that batched Rescue permutation produces same result as permuting each
+// of those states one by one, for batch sizes, which may or may not be
+// multiple of `rescue::BATCH_LANES`
+inline void
+test_permute_batch()
+{
+  constexpr size_t max_n = 9;
+
+  alignas(32) ff::ff_t states0[max_n * rescue::STATE_WIDTH];
+  alignas(32) ff::ff_t states1[max_n * rescue::STATE_WIDTH];
+
+  for (size_t n = 0; n <= max_n; n++) {
+    for (size_t i = 0; i < n * rescue::STATE_WIDTH; i++) {
+      states0[i] = ff::ff_t::random();
+      states1[i] = states0[i];
+    }
+
+    rescue::permute_batch(states0, n);
+    for (size_t i = 0; i < n; i++) {
+      rescue::permute(states1 + i * rescue::STATE_WIDTH);
+    }
+
+    for (size_t i = 0; i < n * rescue::STATE_WIDTH; i++) {
+      assert(states0[i] == states1[i]);
+    }
+  }
+}
+
+// Check that hashing many row-major messages of equal length, a batch at a
+// time, on one or more threads, produces same digests as hashing each message,
+// using `rescue_prime::hash`, for lengths which are not multiple of rate and
+// message counts which are not multiple of lanes
+inline void
+test_hash_many()
+{
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+
+  for (const size_t ilen : { 0ul, 1ul, 7ul, 8ul, 9ul, 24ul, 33ul }) {
+    for (const size_t n : { 0ul, 1ul, 3ul, 4ul, 5ul, 17ul }) {
+      // offset by one element, so that messages are not aligned
+      std::vector<ff::ff_t> in(n * ilen + 1);
+      for (auto& v : in) {
+        v = ff::ff_t::random();
+      }
+
+      std::vector<ff::ff_t> expected(n * D), computed(n * D), threaded(n * D);
+      for (size_t i = 0; i < n; i++) {
+        rescue_prime::hash(in.data() + 1 + i * ilen, ilen, &expected[i * D]);
+      }
+
+      rescue_prime::hash_many(in.data() + 1, n, ilen, computed.data());
+      rescue_prime::hash_many(in.data() + 1, n, ilen, threaded.data(), 3);
+
+      assert(computed == expected);
+      assert(threaded == expected);
+    }
+  }
+}
+
 }
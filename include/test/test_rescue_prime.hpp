@@ -1,4 +1,19 @@
 #pragma once
 
+#include "test_aligned.hpp"
+#include "test_columnar.hpp"
 #include "test_ff.hpp"
+#include "test_ff_ext.hpp"
+#include "test_hasher.hpp"
+#include "test_ingest.hpp"
+#include "test_instrument.hpp"
 #include "test_permutation.hpp"
+#include "test_rescue_prime_ct.hpp"
+#include "test_merkle_file.hpp"
+#include "test_merkle_mountain_range.hpp"
+#include "test_merkle_stream.hpp"
+#include "test_parallel.hpp"
+#include "test_sparse_merkle_tree.hpp"
+#include "test_sponge.hpp"
+#include "test_tree_hash.hpp"
+#include "test_xof.hpp"
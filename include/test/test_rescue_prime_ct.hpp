@@ -0,0 +1,97 @@
+#pragma once
+#include "rescue_prime_ct.hpp"
+#include <cassert>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Check compile-time Rescue permutation using known answer test, both during
+// compilation and at runtime, against `rescue::permute`
+//
+// Test vector taken from
+// https://github.com/novifinancial/winterfell/blob/21173bd/crypto/src/hash/rescue/rp64_256/tests.rs#L69-L105
+inline void
+test_ct_permutation()
+{
+  constexpr rescue::ct::state_t expected{
+    11084501481526603421ul, 6291559951628160880ul, 13626645864671311919ul,
+    18397438323058963117ul, 7443014167353970324ul, 17930833023906771425ul,
+    4275355080008025761ul,  7676681476902901785ul, 3460534574143792217ul,
+    11912731278641497187ul, 8104899243369883110ul, 674509706691634438ul,
+  };
+  constexpr rescue::ct::state_t state{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+  constexpr auto computed = rescue::ct::permute(state);
+
+  static_assert(computed == expected, "Compile-time permutation is wrong !");
+
+  for (size_t i = 0; i < 8; i++) {
+    rescue::ct::state_t st0;
+    alignas(32) ff::ff_t st1[rescue::STATE_WIDTH];
+
+    for (size_t j = 0; j < rescue::STATE_WIDTH; j++) {
+      st0[j] = ff::ff_t::random();
+      st1[j] = st0[j];
+    }
+
+    st0 = rescue::ct::permute(st0);
+    rescue::permute(st1);
+
+    for (size_t j = 0; j < rescue::STATE_WIDTH; j++) {
+      assert(st0[j] == st1[j]);
+    }
+  }
+}
+
+// Check that compile-time evaluable hash, merge and table generator routines
+// produce same digests as runtime Rescue Prime hash and merge routines
+inline void
+test_ct_hash()
+{
+  constexpr size_t depth = 8;
+  constexpr auto table = rescue_prime::ct::empty_subtree_digests<depth>();
+
+  static_assert(table[0] == rescue_prime::digest_t{}, "Empty leaf must be 0 !");
+  static_assert(table[1] == rescue_prime::ct::merge(table[0], table[0]));
+
+  for (size_t i = 0; i < depth; i++) {
+    const auto node = rescue_prime::merge(table[i], table[i]);
+    assert(node == table[i + 1]);
+  }
+
+  for (size_t ilen = 0; ilen <= 24; ilen++) {
+    std::array<ff::ff_t, 24> in{};
+    for (size_t i = 0; i < ilen; i++) {
+      in[i] = ff::ff_t::random();
+    }
+
+    rescue_prime::digest_t out{};
+    rescue_prime::hash(in.data(), ilen, out.data());
+
+    assert(rescue_prime::ct::hash(in.data(), ilen) == out);
+  }
+
+  for (size_t i = 0; i < 8; i++) {
+    rescue_prime::digest_t lhs, rhs;
+    for (size_t j = 0; j < rescue::DIGEST_WIDTH; j++) {
+      lhs[j] = ff::ff_t::random();
+      rhs[j] = ff::ff_t::random();
+    }
+
+    std::array<ff::ff_t, rescue::RATE> in{};
+    std::copy(lhs.begin(), lhs.end(), in.begin());
+    std::copy(rhs.begin(), rhs.end(), in.begin() + rescue::DIGEST_WIDTH);
+
+    const auto computed = rescue_prime::merge(lhs, rhs);
+    assert(computed == rescue_prime::ct::merge(lhs, rhs));
+    assert(computed == rescue_prime::ct::hash(in));
+  }
+
+  constexpr auto iv0 = rescue_prime::ct::domain_iv("rescue-prime/a");
+  constexpr auto iv1 = rescue_prime::ct::domain_iv("rescue-prime/b");
+  constexpr auto iv2 = rescue_prime::ct::domain_iv("rescue-prime/a\0");
+
+  static_assert(iv0 != iv1, "Distinct tags must produce distinct IVs !");
+  static_assert(iv0 != iv2, "Distinct tags must produce distinct IVs !");
+}
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include "sparse_merkle_tree.hpp"
+#include <cassert>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Generates a random Rescue Prime digest
+inline rescue_prime::digest_t
+random_digest()
+{
+  rescue_prime::digest_t digest;
+  for (size_t i = 0; i < rescue::DIGEST_WIDTH; i++) {
+    digest[i] = ff::ff_t::random();
+  }
+  return digest;
+}
+
+// Check that root of a small sparse Merkle tree, built using batch update,
+// matches root of the equivalent dense Merkle tree and that membership/
+// non-membership proofs are verified.
+inline void
+test_smt_dense()
+{
+  constexpr size_t depth = 8;
+  constexpr size_t n_leaves = 1ul << depth;
+
+  using smt_t = merkle::sparse_merkle_tree_t<depth>;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint64_t> dis{ 0ul, n_leaves - 1ul };
+
+  std::vector<merkle::kv_t> kvs;
+  std::vector<rescue_prime::digest_t> leaves(n_leaves);
+
+  for (size_t i = 0; i < n_leaves / 4; i++) {
+    const ff::ff_t key{ dis(gen) };
+    const auto value = random_digest();
+
+    kvs.emplace_back(key, value);
+    leaves[key.v] = value; // last write wins
+  }
+
+  smt_t smt;
+  smt.update(kvs.data(), kvs.size());
+
+  for (size_t w = n_leaves; w > 1; w >>= 1) {
+    for (size_t i = 0; i < (w >> 1); i++) {
+      leaves[i] = rescue_prime::merge(leaves[2 * i], leaves[2 * i + 1]);
+    }
+  }
+  assert(smt.root() == leaves[0]);
+
+  const auto root = smt.root();
+  for (size_t i = 0; i < n_leaves; i++) {
+    const ff::ff_t key{ i };
+    const auto proof = smt.prove(key);
+
+    assert(proof.value == smt.get(key));
+    assert(smt_t::verify(root, proof));
+
+    auto forged = proof;
+    forged.value = forged.is_membership() ? smt_t::DEFAULTS[0] : random_digest();
+    assert(!smt_t::verify(root, forged));
+  }
+}
+
+// Check that 64 -level sparse Merkle tree produces same root, no matter whether
+// keys are updated one by one or in a batch, serially or in parallel, and that
+// removing keys brings back the empty tree.
+inline void
+test_smt_batch_update()
+{
+  using smt_t = merkle::sparse_merkle_tree_t<64>;
+
+  constexpr size_t n = 512;
+
+  std::vector<merkle::kv_t> kvs;
+  for (size_t i = 0; i < n; i++) {
+    kvs.emplace_back(ff::ff_t::random(), random_digest());
+  }
+  // keys sharing a long common path
+  for (size_t i = 0; i < 8; i++) {
+    kvs.emplace_back(ff::ff_t{ kvs[0].first.v ^ i }, random_digest());
+  }
+  // repeated key, last write must win
+  kvs.emplace_back(kvs[1].first, random_digest());
+
+  smt_t smt0, smt1, smt2;
+  for (const auto& [key, value] : kvs) {
+    smt0.update(key, value);
+  }
+  smt1.update(kvs.data(), kvs.size());
+  smt2.update(kvs.data(), kvs.size(), 4);
+
+  assert(smt0.root() == smt1.root());
+  assert(smt0.root() == smt2.root());
+  assert(smt0.root() != smt_t::DEFAULTS[64]);
+  assert(smt2.get(kvs[1].first) == kvs.back().second);
+
+  for (size_t h = 0; h <= 64; h++) {
+    assert(smt0.nodes[h] == smt1.nodes[h]);
+    assert(smt0.nodes[h] == smt2.nodes[h]);
+  }
+
+  const auto root = smt2.root();
+  for (size_t i = 0; i < 16; i++) {
+    const auto member = smt2.prove(kvs[i].first);
+    const auto non_member = smt2.prove(ff::ff_t::random());
+
+    assert(member.is_membership());
+    assert(!non_member.is_membership());
+    assert(smt_t::verify(root, member));
+    assert(smt_t::verify(root, non_member));
+  }
+
+  for (auto& kv : kvs) {
+    kv.second = smt_t::DEFAULTS[0];
+  }
+  smt2.update(kvs.data(), kvs.size(), 3);
+
+  assert(smt2.root() == smt_t::DEFAULTS[64]);
+  for (size_t h = 0; h <= 64; h++) {
+    assert(smt2.nodes[h].empty());
+  }
+}
+
+}
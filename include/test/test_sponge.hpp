@@ -0,0 +1,121 @@
+#pragma once
+#include "sponge.hpp"
+#include "xof.hpp"
+#include <cassert>
+#include <vector>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Check that duplex sponge, initialized with input length as domain separator,
+// squeezes same elements as `rescue_prime::hash_xof`, irrespective of how input
+// and output are splitted into chunks
+inline void
+test_sponge_xof()
+{
+  constexpr size_t olen = 27;
+
+  for (size_t ilen = 1; ilen <= 25; ilen++) {
+    std::vector<ff::ff_t> in(ilen);
+    for (auto& v : in) {
+      v = ff::ff_t::random();
+    }
+
+    std::vector<ff::ff_t> expected(olen);
+    rescue_prime::hash_xof(in.data(), ilen, expected.data(), olen);
+
+    for (size_t chunk = 1; chunk <= 9; chunk++) {
+      rescue_prime::sponge_t sponge{ ff::ff_t{ ilen } };
+
+      for (size_t off = 0; off < ilen; off += chunk) {
+        const size_t len = std::min(chunk, ilen - off);
+        sponge.absorb(std::span{ in.data() + off, len });
+      }
+
+      std::vector<ff::ff_t> out(olen);
+      for (size_t off = 0; off < olen; off += chunk) {
+        const size_t len = std::min(chunk, olen - off);
+        sponge.squeeze(std::span{ out.data() + off, len });
+      }
+
+      assert(out == expected);
+    }
+  }
+}
+
+// Check that interleaved absorption and squeezing, forking and explicit
+// permutation of duplex sponge work same as tracking permutation state by hand
+inline void
+test_sponge_duplex()
+{
+  constexpr size_t R = rescue::RATE;
+
+  std::vector<ff::ff_t> msg(11);
+  for (auto& v : msg) {
+    v = ff::ff_t::random();
+  }
+
+  rescue_prime::sponge_t sponge{ ff::ff_t{ 7ul } };
+
+  alignas(32) ff::ff_t state[rescue::STATE_WIDTH]{};
+  state[rescue::CAPACITY_BEGINS] = ff::ff_t{ 7ul };
+  ff::ff_t* const rate = state + rescue::RATE_BEGINS;
+
+  // absorb 3, squeeze 2
+  sponge.absorb(std::span{ msg.data(), 3 });
+  assert(sponge.position() == 3);
+
+  const auto c0 = sponge.squeeze();
+  const auto c1 = sponge.squeeze();
+
+  for (size_t i = 0; i < 3; i++) {
+    rate[i] = rate[i] + msg[i];
+  }
+  rescue::permute(state);
+
+  assert(c0 == rate[0] && c1 == rate[1]);
+  assert(sponge.position() == 2);
+
+  // fork, then absorb 11 into one of them, which starts at beginning of rate
+  // portion, without permuting state
+  auto fork = sponge.clone();
+  sponge.absorb(msg);
+
+  for (size_t i = 0; i < R; i++) {
+    rate[i] = rate[i] + msg[i];
+  }
+  rescue::permute(state);
+  for (size_t i = R; i < msg.size(); i++) {
+    rate[i - R] = rate[i - R] + msg[i];
+  }
+  assert(sponge.position() == msg.size() - R);
+
+  // squeeze 10, crossing block boundary
+  std::vector<ff::ff_t> out(10);
+  sponge.squeeze(out);
+
+  rescue::permute(state);
+  for (size_t i = 0; i < R; i++) {
+    assert(out[i] == rate[i]);
+  }
+  rescue::permute(state);
+  for (size_t i = R; i < out.size(); i++) {
+    assert(out[i] == rate[i - R]);
+  }
+
+  // forked sponge continues squeezing from where it was forked
+  alignas(32) ff::ff_t st[rescue::STATE_WIDTH];
+  std::memcpy(st, fork.state, sizeof(st));
+
+  const auto c2 = fork.squeeze();
+  assert(c2 == st[rescue::RATE_BEGINS + 2]);
+
+  // explicit permutation resets position, keeping mode
+  fork.permute_now();
+  assert(fork.position() == 0);
+
+  rescue::permute(st);
+  assert(fork.squeeze() == st[rescue::RATE_BEGINS]);
+}
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "tree_hash.hpp"
+#include <cassert>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Computes tree mode digest, one permutation at a time, on a single thread, by
+// following the specification of `rescue_prime::tree_hash`
+inline rescue_prime::digest_t
+tree_hash_reference(const std::vector<ff::ff_t>& in)
+{
+  constexpr size_t C = rescue_prime::TREE_CHUNK_LEN;
+  const size_t nchunks = std::max<size_t>(1, (in.size() + C - 1) / C);
+
+  auto absorb = [](const ff::ff_t* src,
+                   const size_t len,
+                   const size_t cidx,
+                   const uint64_t flags) {
+    alignas(32) ff::ff_t state[rescue::STATE_WIDTH]{};
+    state[rescue::CAPACITY_BEGINS] = ff::ff_t{ len };
+    state[rescue_prime::TREE_CHUNK_INDEX_AT] = ff::ff_t{ cidx };
+    state[rescue_prime::TREE_FLAGS_AT] = ff::ff_t{ flags };
+
+    size_t off = 0;
+    do {
+      ff::ff_t* const rate = state + rescue::RATE_BEGINS;
+      for (size_t i = 0; (i < rescue::RATE) && (off + i < len); i++) {
+        rate[i] = rate[i] + src[off + i];
+      }
+      rescue::permute(state);
+      off += rescue::RATE;
+    } while (off < len);
+
+    rescue_prime::digest_t digest;
+    std::copy(state + rescue::DIGEST_BEGINS,
+              state + rescue::DIGEST_BEGINS + rescue::DIGEST_WIDTH,
+              digest.begin());
+    return digest;
+  };
+
+  std::vector<rescue_prime::digest_t> level;
+  for (size_t i = 0; i < nchunks; i++) {
+    const size_t len = std::min(C, in.size() - std::min(in.size(), i * C));
+    const uint64_t flags = rescue_prime::TREE_FLAG_CHUNK |
+                           (nchunks == 1 ? rescue_prime::TREE_FLAG_ROOT : 0);
+
+    level.push_back(absorb(in.data() + i * C, len, i, flags));
+  }
+
+  while (level.size() > 1) {
+    const bool is_root = level.size() == 2;
+    const uint64_t flags = rescue_prime::TREE_FLAG_PARENT |
+                           (is_root ? rescue_prime::TREE_FLAG_ROOT : 0);
+
+    std::vector<rescue_prime::digest_t> next;
+    for (size_t i = 0; i + 1 < level.size(); i += 2) {
+      ff::ff_t pair[rescue::RATE];
+      std::copy(level[i].begin(), level[i].end(), pair);
+      std::copy(level[i + 1].begin(), level[i + 1].end(), pair + 4);
+
+      alignas(32) ff::ff_t state[rescue::STATE_WIDTH]{};
+      state[rescue::CAPACITY_BEGINS] = ff::ff_t{ rescue::RATE };
+      state[rescue_prime::TREE_FLAGS_AT] = ff::ff_t{ flags };
+      std::copy(pair, pair + rescue::RATE, state + rescue::RATE_BEGINS);
+      rescue::permute(state);
+
+      rescue_prime::digest_t digest;
+      std::copy(state + rescue::DIGEST_BEGINS,
+                state + rescue::DIGEST_BEGINS + rescue::DIGEST_WIDTH,
+                digest.begin());
+      next.push_back(digest);
+    }
+    if (level.size() & 1ul) {
+      next.push_back(level.back());
+    }
+
+    level = std::move(next);
+  }
+
+  return level[0];
+}
+
+// Check that tree mode hashing produces digest as specified, no matter how many
+// threads are used, and that it's domain separated from `rescue_prime::hash`
+inline void
+test_tree_hash()
+{
+  constexpr size_t C = rescue_prime::TREE_CHUNK_LEN;
+  constexpr size_t ilens[]{ 0, 1, 8, C - 1, C, C + 1, 3 * C + 5, 5 * C };
+
+  for (const size_t ilen : ilens) {
+    std::vector<ff::ff_t> in(ilen);
+    for (auto& v : in) {
+      v = ff::ff_t::random();
+    }
+
+    const auto expected = tree_hash_reference(in);
+
+    for (size_t nthreads = 1; nthreads <= 4; nthreads++) {
+      rescue_prime::digest_t computed;
+      rescue_prime::tree_hash(in.data(), ilen, computed.data(), nthreads);
+
+      assert(computed == expected);
+    }
+
+    rescue_prime::digest_t flat;
+    rescue_prime::hash(in.data(), ilen, flat.data());
+    assert(flat != expected);
+  }
+}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "xof.hpp"
+#include <cassert>
+#include <vector>
+
+// Test functional correctness of Rescue Prime implementation
+namespace test_rphash {
+
+// Check that both sequential and counter mode extendable-output functions
+// produce outputs which are prefixes of longer outputs, starting with digest
+// computed by `rescue_prime::hash`, while counter mode blocks are same as ones
+// computed by permuting, one at a time, state holding block index
+inline void
+test_xof()
+{
+  constexpr size_t max_olen = 75;
+
+  for (size_t ilen = 1; ilen <= 17; ilen++) {
+    std::vector<ff::ff_t> in(ilen);
+    for (auto& v : in) {
+      v = ff::ff_t::random();
+    }
+
+    ff::ff_t digest[rescue::DIGEST_WIDTH];
+    rescue_prime::hash(in.data(), ilen, digest);
+
+    std::vector<ff::ff_t> seq(max_olen), ctr(max_olen);
+    rescue_prime::hash_xof(in.data(), ilen, seq.data(), max_olen);
+    rescue_prime::hash_xof_ctr(in.data(), ilen, ctr.data(), max_olen);
+
+    for (size_t i = 0; i < rescue::DIGEST_WIDTH; i++) {
+      assert(seq[i] == digest[i]);
+    }
+    for (size_t i = 0; i < rescue::RATE; i++) {
+      assert(ctr[i] == seq[i]);
+    }
+
+    // sequential mode, one block at a time
+    alignas(32) ff::ff_t state[rescue::STATE_WIDTH];
+    rescue_prime::absorb(in.data(), ilen, state);
+
+    for (size_t off = rescue::RATE; off < max_olen; off += rescue::RATE) {
+      rescue::permute(state);
+
+      const size_t len = std::min(rescue::RATE, max_olen - off);
+      for (size_t i = 0; i < len; i++) {
+        assert(seq[off + i] == state[rescue::RATE_BEGINS + i]);
+      }
+    }
+
+    // counter mode, one block at a time
+    alignas(32) ff::ff_t seed[rescue::STATE_WIDTH];
+    rescue_prime::absorb(in.data(), ilen, seed);
+
+    for (size_t off = rescue::RATE; off < max_olen; off += rescue::RATE) {
+      alignas(32) ff::ff_t st[rescue::STATE_WIDTH];
+      std::memcpy(st, seed, sizeof(seed));
+
+      const size_t ctr_idx = rescue::CAPACITY_BEGINS + 1;
+      st[ctr_idx] = st[ctr_idx] + ff::ff_t{ off / rescue::RATE };
+      rescue::permute(st);
+
+      const size_t len = std::min(rescue::RATE, max_olen - off);
+      for (size_t i = 0; i < len; i++) {
+        assert(ctr[off + i] == st[rescue::RATE_BEGINS + i]);
+      }
+    }
+
+    // shorter outputs are prefixes of longer ones
+    for (size_t olen = 0; olen < max_olen; olen++) {
+      std::vector<ff::ff_t> pre_seq(olen), pre_ctr(olen);
+      rescue_prime::hash_xof(in.data(), ilen, pre_seq.data(), olen);
+      rescue_prime::hash_xof_ctr(in.data(), ilen, pre_ctr.data(), olen);
+
+      for (size_t i = 0; i < olen; i++) {
+        assert(pre_seq[i] == seq[i]);
+        assert(pre_ctr[i] == ctr[i]);
+      }
+    }
+  }
+}
+
+}
@@ -0,0 +1,182 @@
+#pragma once
+#include "parallel.hpp"
+#include "permutation_batch.hpp"
+#include "rescue_prime.hpp"
+#include <vector>
+
+// Rescue Prime Hashing over prime field Z_q, q = 2^64 - 2^32 + 1
+namespace rescue_prime {
+
+// Tree hashing mode splits input into chunks of these many Z_q elements ( i.e.
+// 8 KiB ), each of which are absorbed independently
+constexpr size_t TREE_CHUNK_LEN = 1024ul;
+
+// Domain separation flags, kept in capacity portion of the permutation state
+// ( at index `TREE_FLAGS_AT` ), when hashing in tree mode, so that tree mode
+// digests never collide with ones produced by `hash`/ `merge`, a chunk is never
+// mistaken for a parent node and root is never mistaken for a subtree.
+constexpr uint64_t TREE_FLAG_CHUNK = 1ul << 0;
+constexpr uint64_t TREE_FLAG_PARENT = 1ul << 1;
+constexpr uint64_t TREE_FLAG_ROOT = 1ul << 2;
+
+// Capacity portion of the state holds number of absorbed elements at index 0,
+// index of the chunk at index 1 and domain separation flags at index 2
+constexpr size_t TREE_CHUNK_INDEX_AT = rescue::CAPACITY_BEGINS + 1;
+constexpr size_t TREE_FLAGS_AT = rescue::CAPACITY_BEGINS + 2;
+
+// Absorbs N chunks, each of `clen` ( > 0 ) elements, laid out contiguously from
+// `in`, into N independent permutation states, which are permuted together, a
+// batch at a time, and writes their digests. `cidx` is index of first chunk.
+static inline void
+tree_hash_chunks(const ff::ff_t* const __restrict in,
+                 const size_t clen,
+                 const size_t n,
+                 const size_t cidx,
+                 const uint64_t flags,
+                 ff::ff_t* const __restrict out)
+{
+  constexpr size_t W = rescue::STATE_WIDTH;
+  constexpr size_t B = rescue::BATCH_LANES;
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+
+  for (size_t i = 0; i < n; i += B) {
+    const size_t cnt = std::min(B, n - i);
+
+    alignas(32) ff::ff_t states[W * B]{};
+    for (size_t j = 0; j < cnt; j++) {
+      states[j * W + rescue::CAPACITY_BEGINS] = ff::ff_t{ clen };
+      states[j * W + TREE_CHUNK_INDEX_AT] = ff::ff_t{ cidx + i + j };
+      states[j * W + TREE_FLAGS_AT] = ff::ff_t{ flags };
+    }
+
+    // each chunk is permuted at least once, so that flags affect the digest
+    for (size_t off = 0; (off < clen) || (off == 0); off += rescue::RATE) {
+      const size_t take = std::min(rescue::RATE, clen - off);
+
+      for (size_t j = 0; j < cnt; j++) {
+        const ff::ff_t* const chunk = in + (i + j) * clen + off;
+        ff::ff_t* const rate = states + j * W + rescue::RATE_BEGINS;
+
+        for (size_t k = 0; k < take; k++) {
+          rate[k] = rate[k] + chunk[k];
+        }
+      }
+
+      rescue::permute_batch(states, cnt);
+    }
+
+    for (size_t j = 0; j < cnt; j++) {
+      const ff::ff_t* const st = states + j * W + rescue::DIGEST_BEGINS;
+      std::copy(st, st + rescue::DIGEST_WIDTH, out + (i + j) * D);
+    }
+  }
+}
+
+// Merges N pairs of digests, laid out contiguously, into N parent digests,
+// using domain separation flags, permuting a batch of states at a time.
+static inline void
+tree_hash_parents(const ff::ff_t* const __restrict in,
+                  const size_t n,
+                  const uint64_t flags,
+                  ff::ff_t* const __restrict out)
+{
+  constexpr size_t W = rescue::STATE_WIDTH;
+  constexpr size_t B = rescue::BATCH_LANES;
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+
+  for (size_t i = 0; i < n; i += B) {
+    const size_t cnt = std::min(B, n - i);
+
+    alignas(32) ff::ff_t states[W * B]{};
+    for (size_t j = 0; j < cnt; j++) {
+      ff::ff_t* const st = states + j * W;
+      const ff::ff_t* const pair = in + (i + j) * rescue::RATE;
+
+      st[rescue::CAPACITY_BEGINS] = ff::ff_t{ rescue::RATE };
+      st[TREE_FLAGS_AT] = ff::ff_t{ flags };
+      std::copy(pair, pair + rescue::RATE, st + rescue::RATE_BEGINS);
+    }
+
+    rescue::permute_batch(states, cnt);
+
+    for (size_t j = 0; j < cnt; j++) {
+      const ff::ff_t* const st = states + j * W + rescue::DIGEST_BEGINS;
+      std::copy(st, st + rescue::DIGEST_WIDTH, out + (i + j) * D);
+    }
+  }
+}
+
+// Given N ( >= 0 ) -many Z_q elements as input, this routine computes Rescue
+// prime digest of four Z_q elements, in tree hashing mode, using `nthreads`
+// -many threads of given pool ( or default one, see `parallel::default_pool` ).
+//
+// Input is split into chunks of `TREE_CHUNK_LEN` elements ( last one may be
+// shorter ), each of which is absorbed independently ( in parallel, across
+// threads and SIMD lanes ), with its length, index and `TREE_FLAG_CHUNK` in
+// capacity. Chunk digests form leaves of a binary tree, where each level is
+// built by merging adjacent pairs, with `TREE_FLAG_PARENT` in capacity, while
+// last node of a level with odd number of nodes is promoted to the level above
+// it. Final merge ( or sole chunk, when input fits in a single chunk ) also
+// sets `TREE_FLAG_ROOT`.
+//
+// Shape of the tree only depends on input length, so digest doesn't depend on
+// `nthreads`. Note, digest is different from what `hash` computes on the same
+// input.
+static inline void
+tree_hash(const ff::ff_t* const __restrict in,   // input elements ∈ Z_q
+          const size_t ilen,                     // number of input elements
+          ff::ff_t* const __restrict out,        // 4 output elements ∈ Z_q
+          const size_t nthreads = 1,             // number of threads to use
+          parallel::pool_t* const pool = nullptr // pool to run threads on
+)
+{
+  constexpr size_t C = TREE_CHUNK_LEN;
+  constexpr size_t D = rescue::DIGEST_WIDTH;
+
+  const size_t full = ilen / C;
+  const size_t tail = ilen - full * C;
+  const size_t nchunks = full + ((tail > 0) || (full == 0));
+
+  if (nchunks == 1) {
+    const uint64_t flags = TREE_FLAG_CHUNK | TREE_FLAG_ROOT;
+    tree_hash_chunks(in, ilen, 1, 0, flags, out);
+    return;
+  }
+
+  std::vector<ff::ff_t> level(nchunks * D);
+
+  auto chunks = [&](size_t beg, size_t end) {
+    const ff::ff_t* const src = in + beg * C;
+    tree_hash_chunks(src, C, end - beg, beg, TREE_FLAG_CHUNK, &level[beg * D]);
+  };
+  parallel::for_each_range(nthreads, full, chunks, pool);
+  if (tail > 0) {
+    const ff::ff_t* const src = in + full * C;
+    tree_hash_chunks(src, tail, 1, full, TREE_FLAG_CHUNK, &level[full * D]);
+  }
+
+  size_t width = nchunks;
+  while (width > 1) {
+    const size_t pairs = width >> 1;
+    const uint64_t flags = TREE_FLAG_PARENT | (width == 2 ? TREE_FLAG_ROOT : 0);
+
+    std::vector<ff::ff_t> next(((width + 1) >> 1) * D);
+
+    auto parents = [&](size_t beg, size_t end) {
+      const ff::ff_t* const src = &level[beg * 2 * D];
+      tree_hash_parents(src, end - beg, flags, &next[beg * D]);
+    };
+    parallel::for_each_range(nthreads, pairs, parents, pool);
+    if (width & 1ul) {
+      const ff::ff_t* const src = &level[(width - 1) * D];
+      std::copy(src, src + D, &next[pairs * D]);
+    }
+
+    level = std::move(next);
+    width = (width + 1) >> 1;
+  }
+
+  std::copy(level.begin(), level.end(), out);
+}
+
+}
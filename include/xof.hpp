@@ -0,0 +1,92 @@
+#pragma once
+#include "permutation_batch.hpp"
+#include "rescue_prime.hpp"
+
+// Rescue Prime Hashing over prime field Z_q, q = 2^64 - 2^32 + 1
+namespace rescue_prime {
+
+// Given N ( > 0 ) -many Z_q elements as input, this routine squeezes M ( >= 0 )
+// -many Z_q elements as output, i.e. it's an extendable-output function, where
+// after absorbing input ( see `absorb` ), all eight rate elements are squeezed
+// per permutation, permuting state between consecutive blocks of output.
+//
+// Output of length M is a prefix of output of any length > M, while first four
+// output elements are same as digest computed by `hash`.
+static inline void
+hash_xof(const ff::ff_t* const __restrict in, // input elements ∈ Z_q
+         const size_t ilen,                   // number of input elements
+         ff::ff_t* const __restrict out,      // output elements ∈ Z_q
+         const size_t olen                    // number of output elements
+)
+{
+  alignas(32) ff::ff_t state[rescue::STATE_WIDTH];
+  absorb(in, ilen, state);
+
+  for (size_t off = 0; off < olen; off += rescue::RATE) {
+    if (off > 0) {
+      rescue::permute(state);
+    }
+
+    const size_t cnt = std::min(rescue::RATE, olen - off);
+    std::memcpy(out + off, state + rescue::RATE_BEGINS, cnt << 3);
+  }
+}
+
+// Given N ( > 0 ) -many Z_q elements as input, this routine squeezes M ( >= 0 )
+// -many Z_q elements as output, same as `hash_xof` does, but in counter mode,
+// so that blocks of output are independent of each other and can be computed
+// lane-parallel, which is much faster for large M.
+//
+// Say S is the state after absorbing input, then first block of eight output
+// elements is rate portion of S ( i.e. same as `hash_xof`, hence first four of
+// them are same as digest computed by `hash` ), while j-th block | j > 0 is
+// rate portion of permuted S, where j is added to second capacity element of S
+// before permuting. States of `BATCH_LANES` -many consecutive blocks are
+// permuted together, see `rescue::permute_batch`.
+//
+// Output of length M is a prefix of output of any length > M, while beyond
+// first eight elements, output is different from what `hash_xof` produces.
+static inline void
+hash_xof_ctr(const ff::ff_t* const __restrict in, // input elements ∈ Z_q
+             const size_t ilen,                   // number of input elements
+             ff::ff_t* const __restrict out,      // output elements ∈ Z_q
+             const size_t olen                    // number of output elements
+)
+{
+  constexpr size_t W = rescue::STATE_WIDTH;
+  constexpr size_t B = rescue::BATCH_LANES;
+  constexpr size_t R = rescue::RATE;
+
+  alignas(32) ff::ff_t seed[W];
+  absorb(in, ilen, seed);
+
+  std::memcpy(out, seed + rescue::RATE_BEGINS, std::min(R, olen) << 3);
+
+  // # -of output blocks, except first one i.e. ⌈(M - 8) / 8⌉
+  const size_t blk_cnt = olen > R ? (olen - 1) / R : 0;
+
+  for (size_t i = 0; i < blk_cnt; i += B) {
+    const size_t cnt = std::min(B, blk_cnt - i);
+
+    alignas(32) ff::ff_t states[W * B];
+    for (size_t j = 0; j < cnt; j++) {
+      ff::ff_t* const st = states + j * W;
+      std::memcpy(st, seed, sizeof(seed));
+
+      constexpr size_t ctr_idx = rescue::CAPACITY_BEGINS + 1;
+      st[ctr_idx] = st[ctr_idx] + ff::ff_t{ i + j + 1 };
+    }
+
+    rescue::permute_batch(states, cnt);
+
+    for (size_t j = 0; j < cnt; j++) {
+      const size_t off = (i + j + 1) * R;
+      const size_t len = std::min(R, olen - off);
+
+      const ff::ff_t* const st = states + j * W + rescue::RATE_BEGINS;
+      std::memcpy(out + off, st, len << 3);
+    }
+  }
+}
+
+}
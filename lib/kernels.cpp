@@ -0,0 +1,145 @@
+// Entry points of `librescue_prime.so`, compiled once per backend, where
+// `RP_BACKEND` names the backend ( see Makefile ), so that each object file
+// holds kernels built with its own target flags.
+//
+// Header-only routines are `static inline`, but member functions and templates
+// they use have vague linkage, which linker would merge across object files,
+// possibly picking an AVX512 build of a routine for a generic caller. So
+// namespaces of this project are renamed per backend, while system headers are
+// included before doing so, keeping them untouched. Standard library templates,
+// instantiated here, are made local to object file, after compiling it ( see
+// Makefile ).
+#include "kernels.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cctype>
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+#if defined __x86_64__
+#include <immintrin.h>
+#elif defined __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+#if !defined RP_BACKEND
+#error "Backend must be named, using -DRP_BACKEND=<name> !"
+#endif
+
+#define RP_CONCAT_(a, b) a##_##b
+#define RP_CONCAT(a, b) RP_CONCAT_(a, b)
+#define RP_STRINGIFY_(a) #a
+#define RP_STRINGIFY(a) RP_STRINGIFY_(a)
+
+#define ff RP_CONCAT(ff, RP_BACKEND)
+#define rescue RP_CONCAT(rescue, RP_BACKEND)
+#define rescue_prime RP_CONCAT(rescue_prime, RP_BACKEND)
+#define instrument RP_CONCAT(instrument, RP_BACKEND)
+#define parallel RP_CONCAT(parallel, RP_BACKEND)
+
+#include "rescue_prime.hpp"
+
+namespace {
+
+static_assert(sizeof(ff::ff_t) == sizeof(uint64_t),
+              "Z_q element must be passed as a 64 -bit unsigned integer !");
+static_assert(std::is_standard_layout_v<ff::ff_t>,
+              "Z_q element must be passed as a 64 -bit unsigned integer !");
+
+// Number of states permuted at a time, when caller's states are not aligned
+constexpr size_t STAGED_STATES = 16ul;
+
+inline const ff::ff_t*
+as_elms(const uint64_t* const ptr)
+{
+  return reinterpret_cast<const ff::ff_t*>(ptr);
+}
+
+inline ff::ff_t*
+as_elms(uint64_t* const ptr)
+{
+  return reinterpret_cast<ff::ff_t*>(ptr);
+}
+
+void
+hash(const uint64_t* const in, const size_t ilen, uint64_t* const out)
+{
+  rescue_prime::hash(as_elms(in), ilen, as_elms(out));
+}
+
+void
+merge(const uint64_t* const in, uint64_t* const out)
+{
+  const ff::ff_t* const elms = as_elms(in);
+  rescue_prime::merge(elms, elms + rescue::DIGEST_WIDTH, as_elms(out));
+}
+
+void
+hash_many(const uint64_t* const in,
+          const size_t n,
+          const size_t ilen,
+          uint64_t* const out,
+          const size_t nthreads)
+{
+  rescue_prime::hash_many(as_elms(in), n, ilen, as_elms(out), nthreads);
+}
+
+void
+merge_many(const uint64_t* const in,
+           const size_t n,
+           uint64_t* const out,
+           const size_t nthreads)
+{
+  rescue_prime::merge_many(as_elms(in), n, as_elms(out), nthreads);
+}
+
+// States are permuted in place, when caller's buffer is aligned to 32 -bytes,
+// otherwise they are staged through an aligned buffer, a chunk at a time
+void
+permute_batch(uint64_t* const states, const size_t n)
+{
+  constexpr size_t W = rescue::STATE_WIDTH;
+
+  if (ff::is_aligned<32>(states)) {
+    rescue::permute_batch(as_elms(states), n);
+    return;
+  }
+
+  alignas(32) ff::ff_t staged[STAGED_STATES * W];
+
+  for (size_t i = 0; i < n; i += STAGED_STATES) {
+    const size_t cnt = std::min(STAGED_STATES, n - i);
+    ff::ff_t* const st = as_elms(states + i * W);
+
+    std::copy_n(st, cnt * W, staged);
+    rescue::permute_batch(staged, cnt);
+    std::copy_n(staged, cnt * W, st);
+  }
+}
+
+}
+
+extern "C" const rp_kernels_t RP_CONCAT(rp_kernels, RP_BACKEND){
+  RP_STRINGIFY(RP_BACKEND), hash, merge, hash_many, merge_many, permute_batch,
+};
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Entry points of `librescue_prime.so`, as compiled for one backend, see
+// kernels.cpp, one set of which is picked at runtime, see rescue_prime.cpp
+struct rp_kernels_t
+{
+  const char* name;
+
+  void (*hash)(const uint64_t*, size_t, uint64_t*);
+  void (*merge)(const uint64_t*, uint64_t*);
+  void (*hash_many)(const uint64_t*, size_t, size_t, uint64_t*, size_t);
+  void (*merge_many)(const uint64_t*, size_t, uint64_t*, size_t);
+  void (*permute_batch)(uint64_t*, size_t);
+};
+
+#if defined __x86_64__
+extern "C" const rp_kernels_t rp_kernels_generic;
+extern "C" const rp_kernels_t rp_kernels_avx2;
+extern "C" const rp_kernels_t rp_kernels_avx512;
+#elif defined __aarch64__
+extern "C" const rp_kernels_t rp_kernels_neon;
+#else
+extern "C" const rp_kernels_t rp_kernels_generic;
+#endif
@@ -0,0 +1,110 @@
+// C interface of `librescue_prime.so` ( see rescue_prime.h ), which forwards
+// each call to kernels of the best backend supported by running CPU, picked
+// once, on first call.
+#include "kernels.hpp"
+#include "rescue_prime.h"
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+
+#define RP_EXPORT __attribute__((visibility("default")))
+
+namespace {
+
+// Whether running CPU supports micro-architecture level, given backend was
+// compiled for, see target flags of each backend, in Makefile
+bool
+supported(const rp_kernels_t& k)
+{
+#if defined __x86_64__
+  __builtin_cpu_init();
+
+  if (&k == &rp_kernels_avx512) {
+    return __builtin_cpu_supports("x86-64-v4");
+  }
+  if (&k == &rp_kernels_avx2) {
+    return __builtin_cpu_supports("x86-64-v3");
+  }
+#endif
+
+  (void)k;
+  return true;
+}
+
+// Picks backend named by `RP_BACKEND` environment variable, when CPU supports
+// it, otherwise best one supported by CPU
+const rp_kernels_t&
+select()
+{
+#if defined __x86_64__
+  const auto all = { &rp_kernels_avx512, &rp_kernels_avx2, &rp_kernels_generic };
+#elif defined __aarch64__
+  const auto all = { &rp_kernels_neon };
+#else
+  const auto all = { &rp_kernels_generic };
+#endif
+
+  if (const char* const name = std::getenv("RP_BACKEND")) {
+    for (const auto* k : all) {
+      if (std::strcmp(k->name, name) == 0 && supported(*k)) {
+        return *k;
+      }
+    }
+  }
+
+  for (const auto* k : all) {
+    if (supported(*k)) {
+      return *k;
+    }
+  }
+
+  return **std::prev(all.end());
+}
+
+const rp_kernels_t&
+kernels()
+{
+  static const rp_kernels_t& k = select();
+  return k;
+}
+
+}
+
+extern "C"
+{
+
+  RP_EXPORT const char* rp_backend(void) { return kernels().name; }
+
+  RP_EXPORT void rp_hash(const uint64_t* in, size_t ilen, uint64_t* out)
+  {
+    kernels().hash(in, ilen, out);
+  }
+
+  RP_EXPORT void rp_merge(const uint64_t* in, uint64_t* out)
+  {
+    kernels().merge(in, out);
+  }
+
+  RP_EXPORT void rp_hash_many(const uint64_t* in,
+                              size_t n,
+                              size_t ilen,
+                              uint64_t* out,
+                              size_t nthreads)
+  {
+    kernels().hash_many(in, n, ilen, out, nthreads);
+  }
+
+  RP_EXPORT void rp_merge_many(const uint64_t* in,
+                               size_t n,
+                               uint64_t* out,
+                               size_t nthreads)
+  {
+    kernels().merge_many(in, n, out, nthreads);
+  }
+
+  RP_EXPORT void rp_permute_batch(uint64_t* states, size_t n)
+  {
+    kernels().permute_batch(states, n);
+  }
+}
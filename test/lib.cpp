@@ -0,0 +1,97 @@
+#include "rescue_prime.h"
+#include "rescue_prime.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Checks that entry points of `librescue_prime.so` produce same output as
+// header-only routines, this program is compiled with, for inputs which are
+// not aligned. Run it with `RP_BACKEND` set, for checking a specific backend.
+int
+main()
+{
+  constexpr size_t D = RP_DIGEST_WIDTH;
+  constexpr size_t W = RP_STATE_WIDTH;
+
+  static_assert(D == rescue::DIGEST_WIDTH);
+  static_assert(W == rescue::STATE_WIDTH);
+
+  // one extra element, so that buffers can be offset from aligned address
+  std::vector<ff::ff_t> elms(64 * W + 1);
+  for (auto& v : elms) {
+    v = ff::ff_t::random();
+  }
+
+  std::vector<uint64_t> raw(elms.size());
+  for (size_t i = 0; i < elms.size(); i++) {
+    raw[i] = elms[i].v;
+  }
+
+  const ff::ff_t* const in = elms.data() + 1;
+  const uint64_t* const raw_in = raw.data() + 1;
+
+  for (const size_t ilen : { 0ul, 1ul, 8ul, 13ul, 100ul }) {
+    ff::ff_t expected[D];
+    rescue_prime::hash(in, ilen, expected);
+
+    uint64_t computed[D];
+    rp_hash(raw_in, ilen, computed);
+    for (size_t i = 0; i < D; i++) {
+      assert(computed[i] == expected[i].v);
+    }
+  }
+
+  {
+    ff::ff_t expected[D];
+    rescue_prime::merge(in, in + D, expected);
+
+    uint64_t computed[D];
+    rp_merge(raw_in, computed);
+    for (size_t i = 0; i < D; i++) {
+      assert(computed[i] == expected[i].v);
+    }
+  }
+
+  for (const size_t nthreads : { 0ul, 1ul, 3ul }) {
+    constexpr size_t n = 37;
+    constexpr size_t ilen = 11;
+
+    std::vector<ff::ff_t> expected(n * D);
+    std::vector<uint64_t> computed(n * D);
+
+    rescue_prime::hash_many(in, n, ilen, expected.data());
+    rp_hash_many(raw_in, n, ilen, computed.data(), nthreads);
+    for (size_t i = 0; i < n * D; i++) {
+      assert(computed[i] == expected[i].v);
+    }
+
+    rescue_prime::merge_many(in, n, expected.data());
+    rp_merge_many(raw_in, n, computed.data(), nthreads);
+    for (size_t i = 0; i < n * D; i++) {
+      assert(computed[i] == expected[i].v);
+    }
+  }
+
+  for (const size_t offset : { 0ul, 1ul }) {
+    constexpr size_t n = 37;
+
+    // states are aligned only when offset is 0
+    ff::aligned_vector_t<uint64_t> states(raw.begin(), raw.end());
+    rp_permute_batch(states.data() + offset, n);
+
+    for (size_t i = 0; i < n; i++) {
+      alignas(32) ff::ff_t expected[W];
+      std::copy_n(elms.data() + offset + i * W, W, expected);
+      rescue::permute(expected);
+
+      for (size_t j = 0; j < W; j++) {
+        assert(states[offset + i * W + j] == expected[j].v);
+      }
+    }
+  }
+
+  std::printf("[test] C interface of librescue_prime.so, using %s backend\n",
+              rp_backend());
+  return EXIT_SUCCESS;
+}
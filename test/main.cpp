@@ -1,11 +1,27 @@
+#include "test/test_aligned.hpp"
+#include "test/test_columnar.hpp"
 #include "test/test_ff.hpp"
+#include "test/test_ff_ext.hpp"
+#include "test/test_hasher.hpp"
+#include "test/test_ingest.hpp"
+#include "test/test_instrument.hpp"
+#include "test/test_merkle_file.hpp"
+#include "test/test_merkle_mountain_range.hpp"
+#include "test/test_merkle_stream.hpp"
+#include "test/test_parallel.hpp"
 #include "test/test_permutation.hpp"
+#include "test/test_rescue_prime_ct.hpp"
+#include "test/test_sparse_merkle_tree.hpp"
+#include "test/test_sponge.hpp"
+#include "test/test_tree_hash.hpp"
+#include "test/test_xof.hpp"
 #include <iostream>
 
 int
 main()
 {
   test_rphash::test_field_ops();
+  test_rphash::test_mul_kernels();
   std::cout << "[test] Rescue Prime field arithmetic\n";
 
 #if defined __AVX2__ && USE_AVX2 != 0
@@ -13,6 +29,7 @@ main()
   test_rphash::test_avx_mod_add();
   test_rphash::test_avx_full_mul();
   test_rphash::test_avx_mod_mul();
+  test_rphash::test_avx_mod_sqr();
   std::cout << "[test] AVX2 -based Rescue Prime field arithmetic\n";
 
 #endif
@@ -22,6 +39,7 @@ main()
   test_rphash::test_avx512_mod_add();
   test_rphash::test_avx512_full_mul();
   test_rphash::test_avx512_mod_mul();
+  test_rphash::test_avx512_mod_sqr();
   std::cout << "[test] AVX512 -based Rescue Prime field arithmetic\n";
 
 #endif
@@ -31,13 +49,76 @@ main()
   test_rphash::test_neon_mod_add();
   test_rphash::test_neon_full_mul();
   test_rphash::test_neon_mod_mul();
+  test_rphash::test_neon_mod_sqr();
   std::cout << "[test] NEON -based Rescue Prime field arithmetic\n";
 
 #endif
 
+  test_rphash::test_ff2_ops();
+  test_rphash::test_ff3_ops();
+  test_rphash::test_ext_many<ff::ff2_t>();
+  test_rphash::test_ext_many<ff::ff3_t>();
+  test_rphash::test_ext_hash<ff::ff2_t>();
+  test_rphash::test_ext_hash<ff::ff3_t>();
+  std::cout << "[test] Extension field arithmetic\n";
+
   test_rphash::test_alphas();
   test_rphash::test_permutation();
+  test_rphash::test_permute_batch();
   std::cout << "[test] Rescue Permutation\n";
 
+  test_rphash::test_hash_many();
+  std::cout << "[test] Batched Rescue Prime Hashing of many messages\n";
+
+  test_rphash::test_ct_permutation();
+  test_rphash::test_ct_hash();
+  std::cout << "[test] Compile-time Rescue Permutation and Hashing\n";
+
+  test_rphash::test_smt_dense();
+  test_rphash::test_smt_batch_update();
+  std::cout << "[test] Sparse Merkle Tree\n";
+
+  test_rphash::test_mmr();
+  std::cout << "[test] Merkle Mountain Range\n";
+
+  test_rphash::test_merkle_file();
+  std::cout << "[test] Memory-mapped on-disk Merkle tree\n";
+
+  test_rphash::test_merkle_stream();
+  std::cout << "[test] Streaming Merkle tree construction\n";
+
+  test_rphash::test_tree_hash();
+  std::cout << "[test] Tree mode Rescue Prime Hashing\n";
+
+  test_rphash::test_midstate();
+  std::cout << "[test] Incremental Rescue Prime Hashing from midstate\n";
+
+  test_rphash::test_xof();
+  std::cout << "[test] Extendable-output Rescue Prime Hashing\n";
+
+  test_rphash::test_sponge_xof();
+  test_rphash::test_sponge_duplex();
+  std::cout << "[test] Duplex Rescue Prime sponge\n";
+
+  test_rphash::test_hash_rows_columnar();
+  std::cout << "[test] Rescue Prime Hashing of rows of column-major matrix\n";
+
+  test_rphash::test_thread_pool();
+  test_rphash::test_caller_pool();
+  test_rphash::test_numa_nodes();
+  std::cout << "[test] Persistent work-stealing thread pool\n";
+
+  test_rphash::test_aligned_buffers();
+  test_rphash::test_unaligned_loads();
+  test_rphash::test_unaligned_hash();
+  std::cout << "[test] Aligned buffers and unaligned input hashing\n";
+
+  test_rphash::test_ingest();
+  std::cout << "[test] Asynchronous double-buffered ingestion\n";
+
+  test_rphash::test_instrumentation();
+  test_rphash::test_instrumentation_parallel();
+  std::cout << "[test] Instrumentation counters\n";
+
   return EXIT_SUCCESS;
 }